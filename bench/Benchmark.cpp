@@ -0,0 +1,42 @@
+#include "Benchmark.hpp"
+
+#include <format>
+
+void BenchmarkRunner::printTable(std::ostream& out) const {
+    out << std::format("{:<40} {:>12} {:>12} {:>12} {:>12} {:>12}\n", "benchmark", "ns/op",
+                       "min ns/op", "cycles/op", "min cyc/op", "ops/s");
+    for (const BenchmarkResult& result : results_) {
+        // The median operations per second
+        const double opsPerSecond = result.nsPerOp > 0 ? 1e9 / result.nsPerOp : 0;
+        out << std::format("{:<40} {:>12.1f} {:>12.1f} {:>12.1f} {:>12.1f} {:>12.0f}\n",
+                           result.name, result.nsPerOp, result.minNsPerOp, result.cyclesPerOp,
+                           result.minCyclesPerOp, opsPerSecond);
+    }
+}
+
+void BenchmarkRunner::writeJson(std::ostream& out) const {
+#ifdef NDEBUG
+    constexpr bool isOptimized = true;
+#else
+    constexpr bool isOptimized = false;
+#endif
+
+    out << "{\n";
+    out << std::format("  \"context\": {{\"compiler\": \"{}\", \"ndebug\": {}, \"warmup_seconds\": "
+                       "{}, \"sample_seconds\": {}, \"samples\": {}}},\n",
+                       __VERSION__, isOptimized, options_.warmupSeconds, options_.sampleSeconds,
+                       options_.samples);
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results_.size(); i++) {
+        const BenchmarkResult& result = results_[i];
+        out << std::format(
+            "    {{\"name\": \"{}\", \"ns_per_op\": {:.3f}, \"min_ns_per_op\": {:.3f}, "
+            "\"cycles_per_op\": {:.3f}, \"min_cycles_per_op\": {:.3f}, "
+            "\"operations_per_sample\": {}, \"samples\": {}}}{}\n",
+            result.name, result.nsPerOp, result.minNsPerOp, result.cyclesPerOp,
+            result.minCyclesPerOp, result.operationsPerSample, result.samples,
+            i + 1 < results_.size() ? "," : "");
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
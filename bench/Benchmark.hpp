@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/Perf.hpp"
+#include "common/Statistics.hpp"
+
+/// Keeps the compiler from optimizing away the computation of `value`
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    __asm__ volatile("" : : "r,m"(value) : "memory");
+}
+
+struct BenchmarkOptions {
+    double warmupSeconds = 0.2;   // Minimum time spent running before measuring
+    double sampleSeconds = 0.01;  // Target duration of a sample, sets the operations per sample
+    int samples = 30;
+    std::string_view filter;  // Only benchmarks whose name contains it are run
+};
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t operationsPerSample = 0;
+    int samples = 0;
+    double nsPerOp = 0;         // Median over the samples
+    double minNsPerOp = 0;      // Best sample
+    double cyclesPerOp = 0;     // Median over the samples, in TSC (reference) cycles
+    double minCyclesPerOp = 0;  // Best sample, in TSC (reference) cycles
+};
+
+/// Runs benchmarks with a warm-up and repeated samples, and keeps their results.
+///
+/// An operation is `operation(index)`, with `index` counting from 0 in every sample so that an
+/// operation can pick distinct inputs. `setup()` runs untimed before every sample, e.g. to clear a
+/// cache. The warm-up grows the number of operations per sample until a sample lasts about
+/// `sampleSeconds`, so that the clock resolution and the loop overhead are negligible.
+class BenchmarkRunner {
+   public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options) : options_(options) {}
+
+    template <typename Setup, typename Operation>
+    void run(const std::string& name, Setup&& setup, Operation&& operation) {
+        if (!name.contains(options_.filter)) return;
+
+        constexpr uint64_t maxOperationsPerSample = uint64_t{1} << 32;
+        uint64_t operations = 1;
+        const Clock::time_point warmupStart = Clock::now();
+        while (true) {
+            const Sample sample = measure(setup, operation, operations);
+            if (sample.seconds < options_.sampleSeconds && operations < maxOperationsPerSample) {
+                operations *= 2;
+            } else if (secondsSince(warmupStart) >= options_.warmupSeconds) {
+                break;
+            }
+        }
+
+        std::vector<double> nsPerOp, cyclesPerOp;
+        nsPerOp.reserve(options_.samples);
+        cyclesPerOp.reserve(options_.samples);
+        for (int i = 0; i < options_.samples; i++) {
+            const Sample sample = measure(setup, operation, operations);
+            nsPerOp.push_back(sample.seconds * 1e9 / static_cast<double>(operations));
+            cyclesPerOp.push_back(static_cast<double>(sample.cycles) /
+                                  static_cast<double>(operations));
+        }
+
+        results_.push_back({
+            .name = name,
+            .operationsPerSample = operations,
+            .samples = options_.samples,
+            .nsPerOp = percentile(nsPerOp, 0.5),
+            .minNsPerOp = std::ranges::min(nsPerOp),
+            .cyclesPerOp = percentile(cyclesPerOp, 0.5),
+            .minCyclesPerOp = std::ranges::min(cyclesPerOp),
+        });
+    }
+
+    template <typename Operation>
+    void run(const std::string& name, Operation&& operation) {
+        run(name, [] {}, std::forward<Operation>(operation));
+    }
+
+    [[nodiscard]] const std::vector<BenchmarkResult>& results() const { return results_; }
+
+    /// Human readable table of the results
+    void printTable(std::ostream& out) const;
+
+    /// Results as JSON, stable in keys and order so that runs of two builds can be diffed
+    void writeJson(std::ostream& out) const;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Sample {
+        double seconds;
+        uint64_t cycles;
+    };
+
+    const BenchmarkOptions options_;
+    std::vector<BenchmarkResult> results_;
+
+    template <typename Setup, typename Operation>
+    static Sample measure(Setup& setup, Operation& operation, const uint64_t operations) {
+        setup();
+
+        const Clock::time_point start = Clock::now();
+        const uint64_t startCycles = get_cycles();
+        for (uint64_t i = 0; i < operations; i++) operation(i);
+        const uint64_t cycles = get_cycles() - startCycles;
+
+        return {secondsSince(start), cycles};
+    }
+
+    static double secondsSince(const Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+};
+
+/// Registers benchmarks: `BENCHMARKS(name) { runner.run(...); }`, run by bench/main.cpp
+struct BenchmarkSuite {
+    const char* name;
+    void (*run)(BenchmarkRunner& runner);
+};
+
+inline std::vector<BenchmarkSuite>& benchmarkRegistry() {
+    static std::vector<BenchmarkSuite> registry;
+    return registry;
+}
+
+struct BenchmarkRegistration {
+    BenchmarkRegistration(const char* name, void (*run)(BenchmarkRunner&)) {
+        benchmarkRegistry().push_back({name, run});
+    }
+};
+
+#define BENCHMARKS(name)                                                  \
+    static void name(BenchmarkRunner& runner);                            \
+    static const BenchmarkRegistration name##Registration_{#name, &name}; \
+    static void name(BenchmarkRunner& runner)
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "testing/Viewers.hpp"
+#include "world/Chunk.hpp"
+#include "world/HeightMap.hpp"
+#include "world/Terrain.hpp"
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+constexpr int RENDER_DISTANCE = 2;  // Around the spawn, enough for every neighbour to exist
+
+void benchmarkTransforms(BenchmarkRunner& runner, const std::string& name, const Terrain& terrain,
+                         Chunk& chunk) {
+    const auto adjacentChunks = terrain.findAdjacentChunks(chunk);
+    runner.run(name, [&](uint64_t) {
+        chunk.generateTransforms(adjacentChunks[0], adjacentChunks[1], adjacentChunks[2],
+                                 adjacentChunks[3], adjacentChunks[4], adjacentChunks[5]);
+        doNotOptimize(chunk.getMeshIndices().data());
+    });
+}
+
+}  // namespace
+
+BENCHMARKS(chunkBenchmarks) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    const int groundHeight = terrain.generateSpawnColumn(0, 0);
+    terrain.fill(viewerAt({0.5f, 0.5f, static_cast<float>(groundHeight)}), RENDER_DISTANCE);
+
+    // The surface chunk holds most of the faces, the one below it is solid and almost faceless
+    const int surfaceZ = (groundHeight - 1) / Chunk::SIZE_Z;
+    Chunk& surface = *terrain.findChunk({0, 0, surfaceZ});
+    Chunk& underground = *terrain.findChunk({0, 0, std::max(surfaceZ - 1, 0)});
+    Chunk& sky = *terrain.findChunk({0, 0, surfaceZ + 1});
+
+    Chunk generated(0, 0, surfaceZ);
+    runner.run("chunk/generate_surface", [&](uint64_t) {
+        generated.generate(SEED, MAP_HEIGHT_BLOCKS);
+        doNotOptimize(generated.getData());
+    });
+    runner.run("chunk/generate_surface_cold_heights", [&](uint64_t) {
+        clearHeightCache();
+        generated.generate(SEED, MAP_HEIGHT_BLOCKS);
+        doNotOptimize(generated.getData());
+    });
+
+    benchmarkTransforms(runner, "chunk/generateTransforms_surface", terrain, surface);
+    benchmarkTransforms(runner, "chunk/generateTransforms_underground", terrain, underground);
+    benchmarkTransforms(runner, "chunk/generateTransforms_sky", terrain, sky);
+
+    runner.run("chunk/generateTransforms_surface_isolated", [&](uint64_t) {
+        surface.generateTransforms(std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                                   std::nullopt, std::nullopt);
+        doNotOptimize(surface.getMeshIndices().data());
+    });
+
+    std::vector<const Chunk*> chunks;
+    chunks.reserve(terrain.chunks().size());
+    terrain.chunks().forEach([&](const Chunk& chunk) { chunks.push_back(&chunk); });
+    runner.run("terrain/findAdjacentChunks", [&](const uint64_t i) {
+        doNotOptimize(terrain.findAdjacentChunks(*chunks[i % chunks.size()]));
+    });
+
+    // An explosion in the ground and its repair, remeshing the chunks around the spawn: the chunks
+    // found above are replaced
+    const TerrainViewer viewer = viewerAt({0.5f, 0.5f, static_cast<float>(groundHeight)});
+    runner.run("terrain/fillSphere_remesh", [&](const uint64_t i) {
+        const Block block{i % 2 == 0 ? BlockType::BLOCK_AIR : BlockType::BLOCK_STONE};
+        doNotOptimize(terrain.fillSphere({0.0f, 0.0f, static_cast<float>(groundHeight)}, 8.0f,
+                                         block));
+        terrain.update(viewer, RENDER_DISTANCE);
+        doNotOptimize(terrain.meshedChunks().data());
+    });
+}
@@ -0,0 +1,101 @@
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "absl/container/flat_hash_map.h"
+#include "common/UtilityStructures.hpp"
+#include "world/Chunk.hpp"
+#include "world/HeightMap.hpp"
+
+// The same region of the world in every chunk configuration: a configuration with smaller chunks
+// draws more meshes for the region but remeshes less after a block changes.
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+constexpr int REGION_SIZE = 64;  // In blocks, a multiple of every configuration's extents
+
+/// The chunks of the REGION_SIZE^3 blocks at the origin, generated with a border of one chunk so
+/// that every chunk of the region has its six neighbours
+template <typename ChunkType>
+class ChunkRegion {
+   public:
+    constexpr static Vector3Int REGION_CHUNKS = {REGION_SIZE / ChunkType::SIZE_X,
+                                                 REGION_SIZE / ChunkType::SIZE_Y,
+                                                 REGION_SIZE / ChunkType::SIZE_Z};
+
+    ChunkRegion() {
+        for (int x = -1; x <= REGION_CHUNKS.x; x++) {
+            for (int y = -1; y <= REGION_CHUNKS.y; y++) {
+                for (int z = -1; z <= REGION_CHUNKS.z; z++) {
+                    auto chunk = std::make_unique<ChunkType>(x, y, z);
+                    chunk->generate(SEED, MAP_HEIGHT_BLOCKS);
+                    if (x >= 0 && x < REGION_CHUNKS.x && y >= 0 && y < REGION_CHUNKS.y &&
+                        z >= 0 && z < REGION_CHUNKS.z) {
+                        region_.push_back(chunk.get());
+                    }
+                    chunks_.emplace(Vector3Int{x, y, z}, std::move(chunk));
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] const std::vector<ChunkType*>& region() const { return region_; }
+
+    /// Chunk holding the highest block of the column at the origin
+    [[nodiscard]] ChunkType& surfaceChunk() const {
+        const int surfaceZ = (getHeight(0, 0, SEED, MAP_HEIGHT_BLOCKS) - 1) / ChunkType::SIZE_Z;
+        return *chunks_.at({0, 0, surfaceZ});
+    }
+
+    void generateTransforms(ChunkType& chunk) const {
+        auto find = [&](const int dx, const int dy, const int dz) -> OptionalRef<ChunkType> {
+            const auto it = chunks_.find({chunk.getX() + dx, chunk.getY() + dy, chunk.getZ() + dz});
+            return it != chunks_.end() ? OptionalRef<ChunkType>{*it->second} : std::nullopt;
+        };
+        chunk.generateTransforms(find(1, 0, 0), find(-1, 0, 0), find(0, 1, 0), find(0, -1, 0),
+                                 find(0, 0, 1), find(0, 0, -1));
+    }
+
+   private:
+    absl::flat_hash_map<Vector3Int, std::unique_ptr<ChunkType>> chunks_;
+    std::vector<ChunkType*> region_;
+};
+
+template <typename ChunkType>
+void benchmarkConfiguration(BenchmarkRunner& runner) {
+    const std::string prefix = std::format("chunk/{}x{}x{}/", ChunkType::SIZE_X, ChunkType::SIZE_Y,
+                                           ChunkType::SIZE_Z);
+    const ChunkRegion<ChunkType> region;
+
+    runner.run(prefix + "generate_region", [&](uint64_t) {
+        for (ChunkType* chunk : region.region()) {
+            chunk->generate(SEED, MAP_HEIGHT_BLOCKS);
+            doNotOptimize(chunk->getData());
+        }
+    });
+    // A mesh, hence a draw call, per chunk of the region
+    runner.run(prefix + "generateTransforms_region", [&](uint64_t) {
+        for (ChunkType* chunk : region.region()) {
+            region.generateTransforms(*chunk);
+            doNotOptimize(chunk->getMeshIndices().data());
+        }
+    });
+    // What editing a block of the surface costs to remesh
+    ChunkType& surface = region.surfaceChunk();
+    runner.run(prefix + "generateTransforms_surface", [&](uint64_t) {
+        region.generateTransforms(surface);
+        doNotOptimize(surface.getMeshIndices().data());
+    });
+}
+
+}  // namespace
+
+BENCHMARKS(chunkDimensionBenchmarks) {
+    benchmarkConfiguration<SmallChunk>(runner);
+    benchmarkConfiguration<Chunk>(runner);
+    benchmarkConfiguration<TallChunk>(runner);
+}
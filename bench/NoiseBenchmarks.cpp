@@ -0,0 +1,54 @@
+#include "Benchmark.hpp"
+#include "world/HeightMap.hpp"
+#include "world/PerlinNoise.hpp"
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+constexpr int WARM_AREA_SIZE = 256;   // Side of the square of block columns kept in the cache
+constexpr int COLD_AREA_SIZE = 4096;  // Side of the square walked through with an empty cache
+
+// Same parameters as the terrain
+constexpr int OCTAVES = 6;
+constexpr float LACUNARITY = 2.0f;
+constexpr float GAIN = 0.5f;
+constexpr float NOISE_SCALE = 0.005f;
+
+// Block column visited by the operation `index`, walking a square row by row
+int columnX(const uint64_t index, const int areaSize) { return static_cast<int>(index % areaSize); }
+int columnY(const uint64_t index, const int areaSize) {
+    return static_cast<int>(index / areaSize % areaSize);
+}
+
+}  // namespace
+
+BENCHMARKS(noiseBenchmarks) {
+    runner.run("noise/stb_perlin_noise2_seed", [](const uint64_t i) {
+        const float x = static_cast<float>(columnX(i, WARM_AREA_SIZE)) * NOISE_SCALE;
+        const float y = static_cast<float>(columnY(i, WARM_AREA_SIZE)) * NOISE_SCALE;
+        doNotOptimize(stb_perlin_noise2_seed(x, y, SEED));
+    });
+
+    runner.run("noise/fBm", [](const uint64_t i) {
+        const float x = static_cast<float>(columnX(i, WARM_AREA_SIZE)) * NOISE_SCALE;
+        const float y = static_cast<float>(columnY(i, WARM_AREA_SIZE)) * NOISE_SCALE;
+        doNotOptimize(fBm(x, y, OCTAVES, LACUNARITY, GAIN, SEED));
+    });
+
+    // Every column of a sample is distinct, so every lookup misses and fills the cache
+    runner.run("height/getHeight_cold", clearHeightCache, [](const uint64_t i) {
+        doNotOptimize(getHeight(columnX(i, COLD_AREA_SIZE), columnY(i, COLD_AREA_SIZE), SEED,
+                                MAP_HEIGHT_BLOCKS));
+    });
+
+    clearHeightCache();
+    for (int x = 0; x < WARM_AREA_SIZE; x++) {
+        for (int y = 0; y < WARM_AREA_SIZE; y++) (void)getHeight(x, y, SEED, MAP_HEIGHT_BLOCKS);
+    }
+    runner.run("height/getHeight_warm", [](const uint64_t i) {
+        doNotOptimize(getHeight(columnX(i, WARM_AREA_SIZE), columnY(i, WARM_AREA_SIZE), SEED,
+                                MAP_HEIGHT_BLOCKS));
+    });
+    clearHeightCache();
+}
@@ -0,0 +1,68 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "testing/Viewers.hpp"
+#include "world/Raycast.hpp"
+#include "world/Terrain.hpp"
+
+// One operation is one ray: rays per second are the ops/s column
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+constexpr int RENDER_DISTANCE = 4;
+constexpr size_t RAY_COUNT = 4096;
+
+struct Ray {
+    Vector3 origin;
+    Vector3 direction;
+};
+
+/// Rays in random directions from random points of the box around `center`
+std::vector<Ray> randomRays(const Vector3& center, const Vector3& halfExtents) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::normal_distribution<float> direction(0.0f, 1.0f);
+    std::vector<Ray> rays(RAY_COUNT);
+    for (Ray& ray : rays) {
+        ray.origin = {center.x + offset(random) * halfExtents.x,
+                      center.y + offset(random) * halfExtents.y,
+                      center.z + offset(random) * halfExtents.z};
+        ray.direction = {direction(random), direction(random), direction(random)};
+    }
+    return rays;
+}
+
+void benchmarkRays(BenchmarkRunner& runner, const std::string& name, const Terrain& terrain,
+                   const std::vector<Ray>& rays, const float maxDistance) {
+    runner.run(name, [&](const uint64_t i) {
+        const Ray& ray = rays[i % rays.size()];
+        doNotOptimize(raycast(terrain.chunks(), ray.origin, ray.direction, maxDistance));
+    });
+}
+
+}  // namespace
+
+BENCHMARKS(raycastBenchmarks) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    const auto groundHeight = static_cast<float>(terrain.generateSpawnColumn(0, 0));
+    terrain.fill(viewerAt({0.5f, 0.5f, groundHeight}), RENDER_DISTANCE);
+
+    // Picking from the eyes of a player standing on the ground around the spawn
+    std::vector<Ray> eyeRays = randomRays({0.0f, 0.0f, 0.0f}, {8, 8, 0});
+    for (Ray& ray : eyeRays) {
+        const int ground = terrain.generateSpawnColumn(static_cast<int>(std::floor(ray.origin.x)),
+                                                       static_cast<int>(std::floor(ray.origin.y)));
+        ray.origin.z = static_cast<float>(ground) + 1.6f;
+    }
+    benchmarkRays(runner, "raycast/reach_8", terrain, eyeRays, 8.0f);
+    benchmarkRays(runner, "raycast/ground_64", terrain, eyeRays, 64.0f);
+
+    // Line of sight from high above, across the empty chunks of the sky
+    const std::vector<Ray> skyRays = randomRays({0.0f, 0.0f, groundHeight + 80.0f}, {16, 16, 16});
+    benchmarkRays(runner, "raycast/sky_128", terrain, skyRays, 128.0f);
+}
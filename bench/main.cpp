@@ -0,0 +1,65 @@
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "Benchmark.hpp"
+
+namespace {
+
+template <typename T>
+bool parseValue(const std::string_view text, T& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+bool parseOptions(const int argc, char** argv, BenchmarkOptions& options, std::string& jsonPath) {
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) return false;
+
+        const std::string_view value = argv[++i];
+        bool isValid = true;
+        if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--samples") {
+            isValid = parseValue(value, options.samples) && options.samples > 0;
+        } else if (arg == "--json") {
+            jsonPath = value;
+        } else {
+            isValid = false;
+        }
+        if (!isValid) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+/// Runs the registered benchmarks and prints their results, optionally also as JSON
+///
+/// Options: --filter TEXT, --samples N, --json PATH
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    std::string jsonPath;
+    if (!parseOptions(argc, argv, options, jsonPath)) {
+        std::cerr << "Usage: " << argv[0] << " [--filter TEXT] [--samples N] [--json PATH]"
+                  << std::endl;
+        return 1;
+    }
+
+    BenchmarkRunner runner(options);
+    for (const auto& [name, run] : benchmarkRegistry()) run(runner);
+    runner.printTable(std::cout);
+
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        runner.writeJson(json);
+        if (!json) {
+            std::cerr << "Could not write " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
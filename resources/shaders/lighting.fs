@@ -46,7 +46,11 @@ void main()
     vec3 viewD = normalize(viewPos - fragPosition);
     vec3 specular = vec3(0.0);
 
-    vec4 tint = colDiffuse * fragColor;
+    // Sky and block light levels of the face, baked by the mesher in the red and green channels.
+    // Each level is 80% as bright as the one above it.
+    float skyLight = pow(0.8, 15.0 * (1.0 - fragColor.r));
+    float blockLight = pow(0.8, 15.0 * (1.0 - fragColor.g));
+    vec4 tint = colDiffuse * vec4(vec3(max(skyLight, blockLight)), 1.0);
 
     // NOTE: Implement here your fragment shader code
 
@@ -75,6 +79,10 @@ void main()
         }
     }
 
+    // The directional light is the sun, which does not reach caves
+    lightDot *= skyLight;
+    specular *= skyLight;
+
     finalColor = (texelColor*((tint + vec4(specular, 1.0))*vec4(lightDot, 1.0)));
     finalColor += texelColor*(ambient/10.0)*tint;
 
@@ -0,0 +1,164 @@
+#include "AllocationTracker.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Profiler.hpp"
+
+namespace {
+
+struct ThreadAllocations {
+    AllocationCounts counts;
+    // One more slot than zones, for the allocations outside of any zone or beyond MAX_ZONES
+    std::array<ZoneAllocations, AllocationTracker::MAX_ZONES + 1> zones;
+    size_t zoneCount = 0;
+};
+
+// Constant initialized and trivially destructible: usable from operator new at any time, even
+// while a thread starts or exits
+constinit thread_local ThreadAllocations threadAllocations{};
+
+constinit std::atomic<uint64_t> processAllocations{0};
+constinit std::atomic<uint64_t> processFrees{0};
+constinit std::atomic<uint64_t> processBytes{0};
+
+[[maybe_unused]] AllocationCounts& zoneCounts(ThreadAllocations& thread, const char* zone) {
+    for (size_t i = 0; i < thread.zoneCount; i++) {
+        if (thread.zones[i].zone == zone) return thread.zones[i].counts;
+    }
+    if (zone != nullptr && thread.zoneCount >= AllocationTracker::MAX_ZONES) {
+        return zoneCounts(thread, nullptr);
+    }
+    thread.zones[thread.zoneCount] = {zone, {}};
+    return thread.zones[thread.zoneCount++].counts;
+}
+
+}  // namespace
+
+AllocationCounts AllocationTracker::threadCounts() { return threadAllocations.counts; }
+
+AllocationCounts AllocationTracker::processCounts() {
+    return {
+        .allocations = processAllocations.load(std::memory_order_relaxed),
+        .frees = processFrees.load(std::memory_order_relaxed),
+        .bytes = processBytes.load(std::memory_order_relaxed),
+    };
+}
+
+std::span<const ZoneAllocations> AllocationTracker::threadZones() {
+    return {threadAllocations.zones.data(), threadAllocations.zoneCount};
+}
+
+void AllocationTracker::resetThreadZones() { threadAllocations.zoneCount = 0; }
+
+#ifdef MINECRAFT_ALLOCATION_TRACKING
+
+namespace {
+
+void countAllocation(const size_t size) {
+    ThreadAllocations& thread = threadAllocations;
+    AllocationCounts& zone = zoneCounts(thread, ProfileZone::current());
+    thread.counts.allocations++;
+    thread.counts.bytes += size;
+    zone.allocations++;
+    zone.bytes += size;
+
+    processAllocations.fetch_add(1, std::memory_order_relaxed);
+    processBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void countFree() {
+    ThreadAllocations& thread = threadAllocations;
+    thread.counts.frees++;
+    zoneCounts(thread, ProfileZone::current()).frees++;
+
+    processFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+constexpr size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* allocateAligned(const size_t size, const size_t alignment) noexcept {
+    if (alignment <= DEFAULT_ALIGNMENT) return std::malloc(size);
+    // aligned_alloc requires a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+}
+
+/// Allocates like the default operator new: retries through the new handler, nullptr on failure
+void* allocate(size_t size, const size_t alignment) noexcept {
+    if (size == 0) size = 1;
+    while (true) {
+        void* pointer = allocateAligned(size, alignment);
+        if (pointer != nullptr) {
+            countAllocation(size);
+            return pointer;
+        }
+
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) return nullptr;
+        try {
+            handler();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+void* allocateOrThrow(const size_t size, const size_t alignment) {
+    void* pointer = allocate(size, alignment);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void deallocate(void* pointer) noexcept {
+    if (pointer == nullptr) return;
+    countFree();
+    std::free(pointer);
+}
+
+}  // namespace
+
+// Replacements of the global allocation functions, see [new.delete]
+
+void* operator new(const size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](const size_t size) { return allocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(const size_t size, const std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](const size_t size, const std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new(const size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, DEFAULT_ALIGNMENT);
+}
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, DEFAULT_ALIGNMENT);
+}
+void* operator new(const size_t size, const std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](const size_t size, const std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+#endif
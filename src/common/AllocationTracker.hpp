@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/// Heap allocations made through `operator new`, and freed through `operator delete`
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;  // Allocated, frees are not subtracted as sized delete is not always used
+
+    AllocationCounts& operator-=(const AllocationCounts& other) {
+        allocations -= other.allocations;
+        frees -= other.frees;
+        bytes -= other.bytes;
+        return *this;
+    }
+
+    friend AllocationCounts operator-(AllocationCounts left, const AllocationCounts& right) {
+        return left -= right;
+    }
+};
+
+/// Allocations made by a thread while `zone` was its innermost `PROFILE_ZONE`
+struct ZoneAllocations {
+    const char* zone;  // nullptr outside of any zone
+    AllocationCounts counts;
+};
+
+/// Counts the heap allocations of every thread, attributed to the innermost profiler zone.
+///
+/// Only counts when built with MINECRAFT_ALLOCATION_TRACKING, which replaces the global
+/// `operator new` and `operator delete`; otherwise all counts stay 0. Zones are only known when
+/// MINECRAFT_PROFILING is defined too, allocations are attributed to no zone otherwise.
+///
+/// Counters are per thread and never allocate. To measure a frame, take `threadCounts()` before
+/// and after it and subtract, and reset the zone counts at its start.
+class AllocationTracker {
+   public:
+#ifdef MINECRAFT_ALLOCATION_TRACKING
+    constexpr static bool IS_ENABLED = true;
+#else
+    constexpr static bool IS_ENABLED = false;
+#endif
+
+    /// Distinct zones counted per thread, allocations in further zones are attributed to no zone
+    constexpr static size_t MAX_ZONES = 64;
+
+    /// Allocations of the calling thread since it started
+    [[nodiscard]] static AllocationCounts threadCounts();
+
+    /// Allocations of all the threads since the process started
+    [[nodiscard]] static AllocationCounts processCounts();
+
+    /// Allocations of the calling thread per zone since the last `resetThreadZones`, in the order
+    /// the zones first allocated
+    [[nodiscard]] static std::span<const ZoneAllocations> threadZones();
+
+    static void resetThreadZones();
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+/// Occupancy of a completion queue, as seen by its consumer
+struct CompletionQueueStats {
+    size_t capacity = 0;
+    size_t highWaterMark = 0;     // Most items found queued by a drain
+    uint64_t drained = 0;         // Items taken by the consumer since the queue was created
+    uint64_t rejectedPushes = 0;  // Pushes that found the queue full
+};
+
+namespace completion_queue {
+
+// Separates the producer's and the consumer's indices, which would otherwise false share
+constexpr size_t CACHE_LINE_BYTES = 64;
+
+}  // namespace completion_queue
+
+/// Bounded lock-free ring of completed jobs from one producer thread to one consumer thread.
+///
+/// Both sides only touch their own index and read the other's when their cached copy says the
+/// ring is full or empty, so a push or a drained item costs no atomic read-modify-write. A drain
+/// publishes the freed slots once for the whole batch.
+template <typename T, size_t Capacity>
+class SpscCompletionQueue {
+   public:
+    static_assert(std::has_single_bit(Capacity), "The capacity must be a power of two");
+
+    SpscCompletionQueue() : slots_(std::make_unique<T[]>(Capacity)) {}
+
+    SpscCompletionQueue(const SpscCompletionQueue&) = delete;
+    SpscCompletionQueue& operator=(const SpscCompletionQueue&) = delete;
+
+    /// Producer side. Returns false, leaving `item` untouched, if the queue is full.
+    [[nodiscard]] bool tryPush(T&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity) {
+                rejectedPushes_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        slots_[tail & MASK] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side. Calls `function(T&&)` on up to `maxItems` items, oldest first, and returns
+    /// how many were taken.
+    template <typename Function>
+    size_t drain(Function&& function, const size_t maxItems = std::numeric_limits<size_t>::max()) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t queued = tail_.load(std::memory_order_acquire) - head;
+        highWaterMark_ = std::max(highWaterMark_, queued);
+
+        const size_t count = std::min(queued, maxItems);
+        for (size_t i = 0; i < count; i++) function(std::move(slots_[(head + i) & MASK]));
+        if (count > 0) head_.store(head + count, std::memory_order_release);
+        drained_ += count;
+        return count;
+    }
+
+    /// Consumer side
+    [[nodiscard]] CompletionQueueStats stats() const {
+        return {
+            .capacity = Capacity,
+            .highWaterMark = highWaterMark_,
+            .drained = drained_,
+            .rejectedPushes = rejectedPushes_.load(std::memory_order_relaxed),
+        };
+    }
+
+   private:
+    constexpr static size_t MASK = Capacity - 1;
+
+    std::unique_ptr<T[]> slots_;
+
+    // Producer
+    alignas(completion_queue::CACHE_LINE_BYTES) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+    std::atomic<uint64_t> rejectedPushes_{0};
+
+    // Consumer
+    alignas(completion_queue::CACHE_LINE_BYTES) std::atomic<size_t> head_{0};
+    size_t highWaterMark_ = 0;
+    uint64_t drained_ = 0;
+};
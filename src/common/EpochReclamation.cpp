@@ -0,0 +1,67 @@
+#include "EpochReclamation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+// Slot a thread pinned last, tried first: a thread keeps finding its slot free
+thread_local size_t slotHint = 0;
+
+}  // namespace
+
+EpochDomain::~EpochDomain() {
+    for (const Retired& retired : retired_) retired.deleter(retired.object);
+}
+
+EpochDomain::Guard EpochDomain::pin() {
+    // Pinning an epoch read before another thread advanced it only protects more objects
+    const uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    while (true) {
+        for (size_t i = 0; i < MAX_READERS; i++) {
+            const size_t slot = (slotHint + i) % MAX_READERS;
+            uint64_t idle = IDLE;
+            if (readers_[slot].epoch.compare_exchange_strong(idle, epoch,
+                                                             std::memory_order_seq_cst)) {
+                // Pairs with the fence of `collect`: either the collector sees this reader pinned,
+                // or this reader's loads see the unlinks that preceded the collection
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                slotHint = slot;
+                return {this, slot};
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+void EpochDomain::retire(void* object, void (*deleter)(void*)) {
+    const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    const std::scoped_lock lock(retiredMutex_);
+    retired_.push_back({object, deleter, epoch});
+    retiredCount_.store(retired_.size(), std::memory_order_relaxed);
+}
+
+size_t EpochDomain::collect() {
+    if (retiredCount() == 0) return 0;
+
+    std::vector<Retired> freeable;
+    {
+        // Readers are scanned after the objects were retired: those pinned later cannot see them
+        const std::scoped_lock lock(retiredMutex_);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldestPinned = IDLE;
+        for (const ReaderSlot& reader : readers_) {
+            oldestPinned = std::min(oldestPinned, reader.epoch.load(std::memory_order_seq_cst));
+        }
+
+        const auto firstKept = std::partition(
+            retired_.begin(), retired_.end(),
+            [&](const Retired& retired) { return retired.epoch < oldestPinned; });
+        freeable.assign(retired_.begin(), firstKept);
+        retired_.erase(retired_.begin(), firstKept);
+        retiredCount_.store(retired_.size(), std::memory_order_relaxed);
+    }
+    for (const Retired& retired : freeable) retired.deleter(retired.object);
+    return freeable.size();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/// Epoch-based reclamation for lock-free readers.
+///
+/// A reader pins the current epoch for as long as it uses what it found. A writer unlinks an
+/// object so that new readers cannot find it, then retires it: the object is tagged with the epoch,
+/// which advances, and is only freed once every reader pinned at or before that epoch is gone.
+/// Readers never write shared memory besides their own slot, and never wait.
+class EpochDomain {
+   public:
+    /// Readers that can be pinned at once; more wait for a slot
+    constexpr static size_t MAX_READERS = 64;
+
+    /// A pinned epoch, released on destruction. Objects found while it is alive stay alive.
+    class Guard {
+       public:
+        Guard(Guard&& other) noexcept
+            : domain_(std::exchange(other.domain_, nullptr)), slot_(other.slot_) {}
+        Guard& operator=(Guard&&) = delete;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() {
+            if (domain_) domain_->readers_[slot_].epoch.store(IDLE, std::memory_order_release);
+        }
+
+       private:
+        friend class EpochDomain;
+
+        Guard(EpochDomain* domain, const size_t slot) : domain_(domain), slot_(slot) {}
+
+        EpochDomain* domain_;
+        size_t slot_;
+    };
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /// Frees everything retired: no guard may outlive the domain
+    ~EpochDomain();
+
+    [[nodiscard]] Guard pin();
+
+    /// Frees `object` with `deleter` once no reader can see it anymore. New readers must already be
+    /// unable to find it.
+    void retire(void* object, void (*deleter)(void*));
+
+    /// Frees the retired objects no reader can see anymore, returns how many were freed
+    size_t collect();
+
+    /// Objects retired and not freed yet
+    [[nodiscard]] size_t retiredCount() const {
+        return retiredCount_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    constexpr static uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{IDLE};
+    };
+
+    struct Retired {
+        void* object;
+        void (*deleter)(void*);
+        uint64_t epoch;  // Readers pinned at this epoch or before may still see the object
+    };
+
+    std::array<ReaderSlot, MAX_READERS> readers_{};
+    std::atomic<uint64_t> epoch_{1};
+
+    std::mutex retiredMutex_;
+    std::vector<Retired> retired_;
+    std::atomic<size_t> retiredCount_{0};
+};
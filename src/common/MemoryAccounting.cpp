@@ -0,0 +1,99 @@
+#include "MemoryAccounting.hpp"
+
+#include <atomic>
+#include <format>
+
+namespace {
+
+struct Counters {
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> peakBytes{0};
+    std::atomic<size_t> budget{MemoryAccounting::NO_BUDGET};
+};
+
+std::array<Counters, MEMORY_CATEGORY_COUNT> counters;
+
+Counters& countersOf(const MemoryCategory category) {
+    return counters[static_cast<size_t>(category)];
+}
+
+double toMebibytes(const size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+}  // namespace
+
+void MemoryAccounting::add(const MemoryCategory category, const size_t bytes) {
+    Counters& c = countersOf(category);
+    const size_t newBytes = c.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    size_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (newBytes > peak &&
+           !c.peakBytes.compare_exchange_weak(peak, newBytes, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryAccounting::remove(const MemoryCategory category, const size_t bytes) {
+    countersOf(category).bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::bytes(const MemoryCategory category) {
+    return countersOf(category).bytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::peakBytes(const MemoryCategory category) {
+    return countersOf(category).peakBytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::totalBytes() {
+    size_t total = 0;
+    for (const MemoryCategory category : MEMORY_CATEGORIES) total += bytes(category);
+    return total;
+}
+
+void MemoryAccounting::setBudget(const MemoryCategory category, const size_t bytes) {
+    countersOf(category).budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::budget(const MemoryCategory category) {
+    return countersOf(category).budget.load(std::memory_order_relaxed);
+}
+
+bool MemoryAccounting::isOverBudget(const MemoryCategory category) {
+    return bytes(category) > budget(category);
+}
+
+const char* MemoryAccounting::name(const MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::CHUNK_DATA:
+            return "chunk_data";
+        case MemoryCategory::CHUNK_MESHES:
+            return "chunk_meshes";
+        case MemoryCategory::GPU_MESHES:
+            return "gpu_meshes";
+        case MemoryCategory::HEIGHT_CACHE:
+            return "height_cache";
+        case MemoryCategory::WORLD_MAP:
+            return "world_map";
+    }
+    return "unknown";
+}
+
+std::optional<MemoryCategory> MemoryAccounting::categoryFromName(const std::string_view name) {
+    for (const MemoryCategory category : MEMORY_CATEGORIES) {
+        if (name == MemoryAccounting::name(category)) return category;
+    }
+    return std::nullopt;
+}
+
+void MemoryAccounting::dump(std::ostream& out) {
+    out << std::format("{:<14} {:>12} {:>12} {:>12}\n", "memory", "MiB", "peak MiB", "budget MiB");
+    for (const MemoryCategory category : MEMORY_CATEGORIES) {
+        const size_t categoryBudget = budget(category);
+        out << std::format("{:<14} {:>12.1f} {:>12.1f} {:>12}{}\n", name(category),
+                           toMebibytes(bytes(category)), toMebibytes(peakBytes(category)),
+                           categoryBudget == NO_BUDGET
+                               ? std::string("-")
+                               : std::format("{:.1f}", toMebibytes(categoryBudget)),
+                           isOverBudget(category) ? " OVER BUDGET" : "");
+    }
+    out << std::format("{:<14} {:>12.1f}\n", "total", toMebibytes(totalBytes()));
+}
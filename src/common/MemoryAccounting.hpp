@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+/// What world memory is spent on
+enum class MemoryCategory : uint8_t {
+    CHUNK_DATA,    // Blocks of the chunks
+    CHUNK_MESHES,  // Mesh vectors of the chunks, on the CPU
+    GPU_MESHES,    // Mesh buffers uploaded to the GPU
+    HEIGHT_CACHE,  // Cached terrain heights
+    WORLD_MAP,     // Chunk map slots and chunk bookkeeping outside of the blocks and meshes
+};
+
+constexpr size_t MEMORY_CATEGORY_COUNT = 5;
+
+constexpr std::array<MemoryCategory, MEMORY_CATEGORY_COUNT> MEMORY_CATEGORIES = {
+    MemoryCategory::CHUNK_DATA,   MemoryCategory::CHUNK_MESHES, MemoryCategory::GPU_MESHES,
+    MemoryCategory::HEIGHT_CACHE, MemoryCategory::WORLD_MAP,
+};
+
+/// Process-wide byte counters per memory category, with optional budgets.
+///
+/// Owners report what they allocate and free; counters are atomic so any thread can report.
+/// Budgets are not enforced here: owners check `isOverBudget` and stop growing (the terrain stops
+/// generating chunks, the height cache is cleared, new meshes are not uploaded).
+class MemoryAccounting {
+   public:
+    constexpr static size_t NO_BUDGET = std::numeric_limits<size_t>::max();
+
+    static void add(MemoryCategory category, size_t bytes);
+    static void remove(MemoryCategory category, size_t bytes);
+
+    /// Reports that an allocation went from `oldBytes` to `newBytes`
+    static void update(const MemoryCategory category, const size_t oldBytes,
+                       const size_t newBytes) {
+        if (newBytes > oldBytes) add(category, newBytes - oldBytes);
+        if (newBytes < oldBytes) remove(category, oldBytes - newBytes);
+    }
+
+    [[nodiscard]] static size_t bytes(MemoryCategory category);
+    [[nodiscard]] static size_t peakBytes(MemoryCategory category);
+    [[nodiscard]] static size_t totalBytes();
+
+    static void setBudget(MemoryCategory category, size_t bytes);
+    [[nodiscard]] static size_t budget(MemoryCategory category);
+    [[nodiscard]] static bool isOverBudget(MemoryCategory category);
+
+    [[nodiscard]] static const char* name(MemoryCategory category);
+    [[nodiscard]] static std::optional<MemoryCategory> categoryFromName(std::string_view name);
+
+    /// Writes a table of the current, peak and budget bytes of every category
+    static void dump(std::ostream& out);
+};
@@ -0,0 +1,86 @@
+#include "PerfBaseline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <sstream>
+
+std::optional<PerfBaseline> PerfBaseline::parse(std::istream& in) {
+    PerfBaseline baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+
+        std::istringstream fields(line);
+        Entry entry;
+        std::string rest;
+        if (!(fields >> entry.name >> entry.value >> entry.tolerance) || (fields >> rest) ||
+            entry.tolerance < 0) {
+            return std::nullopt;
+        }
+        baseline.entries_.push_back(std::move(entry));
+    }
+    return baseline;
+}
+
+PerfBaseline PerfBaseline::fromMetrics(const std::vector<PerfMetric>& metrics) {
+    PerfBaseline baseline;
+    for (const PerfMetric& metric : metrics) {
+        baseline.entries_.push_back({metric.name, metric.value, metric.defaultTolerance});
+    }
+    return baseline;
+}
+
+void PerfBaseline::write(std::ostream& out) const {
+    out << "# metric value tolerance, see PerfBaseline\n";
+    for (const Entry& entry : entries_) {
+        out << std::format("{} {:.6g} {}\n", entry.name, entry.value, entry.tolerance);
+    }
+}
+
+std::vector<PerfComparison> PerfBaseline::compare(
+    const std::vector<PerfMetric>& metrics, const std::optional<double> toleranceOverride) const {
+    std::vector<PerfComparison> comparisons;
+    for (const PerfMetric& metric : metrics) {
+        PerfComparison comparison{.name = metric.name, .value = metric.value};
+        const auto entry = std::ranges::find(entries_, metric.name, &Entry::name);
+        if (entry != entries_.end()) {
+            comparison.baseline = entry->value;
+            comparison.tolerance = toleranceOverride.value_or(entry->tolerance);
+            if (entry->value != 0) {
+                const double change = (metric.value - entry->value) / std::abs(entry->value);
+                comparison.change = metric.isHigherBetter ? change : -change;
+            } else if (metric.value != 0) {
+                comparison.change = metric.isHigherBetter ? 1.0 : -1.0;  // Grew from nothing
+            }
+            comparison.isRegression = comparison.change < -comparison.tolerance;
+        }
+        comparisons.push_back(comparison);
+    }
+
+    for (const Entry& entry : entries_) {
+        if (std::ranges::find(metrics, entry.name, &PerfMetric::name) != metrics.end()) continue;
+        comparisons.push_back({
+            .name = entry.name,
+            .baseline = entry.value,
+            .tolerance = toleranceOverride.value_or(entry.tolerance),
+            .isRegression = true,
+        });
+    }
+    return comparisons;
+}
+
+void printPerfComparisons(std::ostream& out, const std::vector<PerfComparison>& comparisons) {
+    out << std::format("{:<32} {:>14} {:>14} {:>9} {:>9}\n", "metric", "baseline", "value",
+                       "change", "tolerance");
+    for (const PerfComparison& comparison : comparisons) {
+        auto format = [](const std::optional<double> value) {
+            return value ? std::format("{:.6g}", *value) : std::string("-");
+        };
+        out << std::format("{:<32} {:>14} {:>14} {:>+8.1f}% {:>8.1f}%{}\n", comparison.name,
+                           format(comparison.baseline), format(comparison.value),
+                           comparison.change * 100.0, comparison.tolerance * 100.0,
+                           comparison.isRegression ? "  REGRESSION" : "");
+    }
+}
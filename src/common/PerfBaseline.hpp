@@ -0,0 +1,63 @@
+#pragma once
+
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// A measured performance metric, and which way it regresses
+struct PerfMetric {
+    std::string name;
+    double value = 0;
+    bool isHigherBetter = false;  // Throughputs, as opposed to sizes and times
+    double defaultTolerance = 0;  // Written with new baselines, see `PerfBaseline`
+};
+
+/// Outcome of the comparison of a metric to its baseline
+struct PerfComparison {
+    std::string name;
+    std::optional<double> value{};     // Unset if the run did not measure the metric
+    std::optional<double> baseline{};  // Unset if the baseline has no such metric
+    double tolerance = 0;
+    double change = 0;  // Relative change from the baseline, positive when better
+    bool isRegression = false;
+};
+
+/// Expected values of performance metrics, and how much each may get worse before it is a
+/// regression.
+///
+/// The file holds a metric per line, `name value tolerance`, the tolerance being a fraction of the
+/// value: with a tolerance of 0.25, a throughput regresses below 75% of its baseline and a size
+/// above 125%. Empty lines and lines starting with '#' are ignored.
+class PerfBaseline {
+   public:
+    struct Entry {
+        std::string name;
+        double value = 0;
+        double tolerance = 0;
+    };
+
+    /// Returns nullopt if a line is not a valid entry
+    [[nodiscard]] static std::optional<PerfBaseline> parse(std::istream& in);
+
+    /// Baseline of the given measurements, with their default tolerances
+    [[nodiscard]] static PerfBaseline fromMetrics(const std::vector<PerfMetric>& metrics);
+
+    void write(std::ostream& out) const;
+
+    /// Compares every metric of the run and of the baseline. A metric missing from the run is a
+    /// regression, one missing from the baseline is not. `toleranceOverride` replaces the
+    /// tolerances of the baseline.
+    [[nodiscard]] std::vector<PerfComparison> compare(
+        const std::vector<PerfMetric>& metrics,
+        std::optional<double> toleranceOverride = std::nullopt) const;
+
+    [[nodiscard]] const std::vector<Entry>& entries() const { return entries_; }
+
+   private:
+    std::vector<Entry> entries_;
+};
+
+/// Human readable table of comparisons
+void printPerfComparisons(std::ostream& out, const std::vector<PerfComparison>& comparisons);
@@ -0,0 +1,153 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// A ring of events written by its thread only.
+///
+/// Event n goes to slot n % capacity. The thread bumps `started` before writing a slot and
+/// `published` after, so that a reader copying the slots knows which ones were overwritten
+/// meanwhile: those of the events older than `started - capacity`.
+struct ThreadBuffer {
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> startCycles{0};
+        std::atomic<uint64_t> endCycles{0};
+    };
+
+    const std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(Profiler::EVENTS_PER_THREAD);
+    std::atomic<uint64_t> started{0};    // Events whose slot was written or is being written
+    std::atomic<uint64_t> published{0};  // Events whose slot was written
+
+    int threadId = 0;
+    std::mutex nameMutex;  // Only contended while exporting
+    std::string threadName;
+};
+
+/// Buffers outlive their thread, so that the events of finished threads can still be exported
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    // Reference point to convert TSC cycles to microseconds
+    const Clock::time_point epoch = Clock::now();
+    const uint64_t epochCycles = get_cycles();
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Sets the epoch at startup, before the first zone starts
+[[maybe_unused]] const Registry& startupRegistry = registry();
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadBuffer* buffer = [] {
+        Registry& reg = registry();
+        const std::scoped_lock lock(reg.mutex);
+
+        auto& newBuffer = reg.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        newBuffer->threadId = static_cast<int>(reg.buffers.size());
+        newBuffer->threadName = std::format("thread {}", newBuffer->threadId);
+        return newBuffer.get();
+    }();
+    return *buffer;
+}
+
+}  // namespace
+
+void Profiler::record(const char* name, const uint64_t startCycles, const uint64_t endCycles) {
+    ThreadBuffer& buffer = threadBuffer();
+    const uint64_t index = buffer.published.load(std::memory_order_relaxed);
+    ThreadBuffer::Slot& slot = buffer.slots[index % EVENTS_PER_THREAD];
+
+    // The slot's stores cannot be seen before the bump of `started`
+    buffer.started.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startCycles.store(startCycles, std::memory_order_relaxed);
+    slot.endCycles.store(endCycles, std::memory_order_relaxed);
+    buffer.published.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    const std::scoped_lock lock(buffer.nameMutex);
+    buffer.threadName = name;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+    Registry& reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+
+    const double elapsedMicroseconds =
+        std::chrono::duration<double, std::micro>(Clock::now() - reg.epoch).count();
+    const auto elapsedCycles = static_cast<double>(get_cycles() - reg.epochCycles);
+    const double cyclesPerMicrosecond =
+        elapsedMicroseconds > 0 ? elapsedCycles / elapsedMicroseconds : 1.0;
+    auto toMicroseconds = [&](const uint64_t cycles) {
+        const auto sinceEpoch = static_cast<int64_t>(cycles - reg.epochCycles);
+        return std::max(static_cast<double>(sinceEpoch), 0.0) / cyclesPerMicrosecond;
+    };
+
+    std::ofstream out(path);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool isFirst = true;
+    auto separator = [&] {
+        const char* result = isFirst ? "  " : ",\n  ";
+        isFirst = false;
+        return result;
+    };
+
+    std::vector<ProfileEvent> events;
+    for (const auto& buffer : reg.buffers) {
+        // Copy the published events, then drop those the thread overwrote meanwhile
+        const uint64_t published = buffer->published.load(std::memory_order_acquire);
+        const uint64_t first = published > EVENTS_PER_THREAD ? published - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (uint64_t index = first; index < published; index++) {
+            const ThreadBuffer::Slot& slot = buffer->slots[index % EVENTS_PER_THREAD];
+            events.push_back({slot.name.load(std::memory_order_relaxed),
+                              slot.startCycles.load(std::memory_order_relaxed),
+                              slot.endCycles.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t started = buffer->started.load(std::memory_order_relaxed);
+        const uint64_t overwritten =
+            started > EVENTS_PER_THREAD ? std::min(started - EVENTS_PER_THREAD, published) : 0;
+        const size_t skipped = overwritten > first ? overwritten - first : 0;
+
+        {
+            const std::scoped_lock nameLock(buffer->nameMutex);
+            out << separator()
+                << std::format(
+                       "{{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, "
+                       "\"args\": {{\"name\": \"{}\"}}}}",
+                       buffer->threadId, buffer->threadName);
+        }
+
+        for (size_t i = skipped; i < events.size(); i++) {
+            const ProfileEvent& event = events[i];
+            const double start = toMicroseconds(event.startCycles);
+            const double end = toMicroseconds(event.endCycles);
+            out << separator()
+                << std::format("{{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, "
+                               "\"ts\": {:.3f}, \"dur\": {:.3f}}}",
+                               event.name, buffer->threadId, start, end - start);
+        }
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
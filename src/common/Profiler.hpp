@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Perf.hpp"
+
+/// A timed zone, in TSC cycles
+struct ProfileEvent {
+    const char* name;  // Must outlive the profiler, e.g. a string literal
+    uint64_t startCycles;
+    uint64_t endCycles;
+};
+
+/// Records timed zones in a ring buffer per thread and exports them as a Chrome trace.
+///
+/// Recording takes two `rdtsc` and a few stores into a ring only its thread writes, without a
+/// lock; the exporter copies the rings meanwhile and drops the events overwritten while it copied.
+/// Zones are meant for units of work (a chunk generated, a mesh uploaded, a frame), not for inner
+/// loops. Each thread keeps its last `EVENTS_PER_THREAD` events, enough to see the frames around a
+/// spike.
+class Profiler {
+   public:
+    constexpr static size_t EVENTS_PER_THREAD = size_t{1} << 16;
+
+    static void record(const char* name, uint64_t startCycles, uint64_t endCycles);
+
+    /// Names the calling thread in the exported traces
+    static void setThreadName(const std::string& name);
+
+    /// Writes the recorded events as Chrome trace JSON, to open with chrome://tracing or Perfetto
+    ///
+    /// Returns false if the file could not be written
+    static bool exportChromeTrace(const std::string& path);
+};
+
+/// Records the time between its construction and its destruction, see `PROFILE_ZONE`
+class ProfileZone {
+   public:
+    explicit ProfileZone(const char* name)
+        : name_(name), parent_(current_), startCycles_(get_cycles()) {
+        current_ = name;
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    ~ProfileZone() {
+        Profiler::record(name_, startCycles_, get_cycles());
+        current_ = parent_;
+    }
+
+    /// Name of the innermost zone of the calling thread, nullptr outside of any zone
+    [[nodiscard]] static const char* current() { return current_; }
+
+   private:
+    const char* name_;
+    const char* parent_;
+    const uint64_t startCycles_;
+
+    inline static thread_local const char* current_ = nullptr;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+/// Profiles the rest of the enclosing scope. Compiled out unless MINECRAFT_PROFILING is defined.
+#ifdef MINECRAFT_PROFILING
+#define PROFILE_ZONE(name) const ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
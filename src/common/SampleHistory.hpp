@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "Statistics.hpp"
+
+/// The last `capacity` samples of a measure, e.g. one per frame, oldest first
+class SampleHistory {
+   public:
+    explicit SampleHistory(const size_t capacity) : samples_(capacity, 0.0) {
+        sorted_.reserve(capacity);
+    }
+
+    void push(const double sample) {
+        samples_[next_] = sample;
+        next_ = (next_ + 1) % samples_.size();
+        count_ = std::min(count_ + 1, samples_.size());
+    }
+
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] size_t capacity() const { return samples_.size(); }
+
+    /// `i`-th oldest sample
+    [[nodiscard]] double operator[](const size_t i) const {
+        const size_t first = count_ < samples_.size() ? 0 : next_;
+        return samples_[(first + i) % samples_.size()];
+    }
+
+    /// Nearest-rank percentile of the samples, `p` in [0, 1]
+    [[nodiscard]] double percentile(const double p) const {
+        sorted_.clear();
+        for (size_t i = 0; i < count_; i++) sorted_.push_back((*this)[i]);
+        return ::percentile(sorted_, p);
+    }
+
+   private:
+    std::vector<double> samples_;
+    size_t next_ = 0;
+    size_t count_ = 0;
+
+    mutable std::vector<double> sorted_;  // Scratch space of `percentile`, never reallocated
+};
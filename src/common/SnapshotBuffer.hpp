@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// Hands the latest state of a producer thread to a consumer thread, e.g. the simulation's to the
+/// renderer, without either waiting for the other.
+///
+/// The producer writes a snapshot in its back buffer while the consumer reads its front buffer;
+/// publishing and acquiring swap those with a spare buffer, so the consumer always gets the newest
+/// complete snapshot and snapshots it skipped are simply overwritten.
+template <typename T>
+class SnapshotBuffer {
+   public:
+    /// Producer side: the snapshot to fill before `publish`
+    [[nodiscard]] T& back() { return buffers_[back_]; }
+
+    /// Producer side: makes the back buffer the newest snapshot
+    void publish() {
+        back_ = spare_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    /// Consumer side: the newest snapshot published, which stays valid until the next call
+    [[nodiscard]] const T& acquire() {
+        if (spare_.load(std::memory_order_relaxed) & FRESH) {
+            front_ = spare_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        }
+        return buffers_[front_];
+    }
+
+   private:
+    constexpr static uint8_t INDEX = 0b11;
+    constexpr static uint8_t FRESH = 0b100;  // The spare buffer holds a snapshot not acquired yet
+
+    std::array<T, 3> buffers_{};
+    uint8_t back_ = 0;                // Producer's
+    std::atomic<uint8_t> spare_ = 1;  // Exchanged by both sides
+    uint8_t front_ = 2;               // Consumer's
+};
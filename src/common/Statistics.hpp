@@ -0,0 +1,15 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/// Nearest-rank percentile of `samples`, `p` in [0, 1]. The samples are reordered.
+inline double percentile(std::vector<double>& samples, const double p) {
+    if (samples.empty()) return 0.0;
+
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+    const size_t index = std::clamp<size_t>(rank, 1, samples.size()) - 1;
+    std::ranges::nth_element(samples, samples.begin() + static_cast<std::ptrdiff_t>(index));
+    return samples[index];
+}
@@ -0,0 +1,70 @@
+#include "ChunkRenderer.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#include "common/MemoryAccounting.hpp"
+#include "common/Profiler.hpp"
+#include "raymath.h"
+
+// raylib only uploads 16-bit indices
+static_assert(std::is_same_v<Chunk::MeshIndex, unsigned short>);
+
+ChunkRenderer::~ChunkRenderer() {
+    for (const GpuMesh& gpuMesh : meshes_ | std::views::values) {
+        for (const Mesh& mesh : gpuMesh.submeshes) UnloadMesh(mesh);
+    }
+    MemoryAccounting::remove(MemoryCategory::GPU_MESHES, gpuBytes_);
+}
+
+size_t ChunkRenderer::upload(const Chunk& chunk) {
+    PROFILE_ZONE("upload");
+    const Vector3Int position = {chunk.getX(), chunk.getY(), chunk.getZ()};
+    const auto it = meshes_.find(position);
+
+    // Over budget, meshes are still updated but no new chunk appears
+    if (it == meshes_.end() && MemoryAccounting::isOverBudget(MemoryCategory::GPU_MESHES)) {
+        return 0;
+    }
+
+    if (it != meshes_.end()) {
+        for (const Mesh& mesh : it->second.submeshes) UnloadMesh(mesh);
+        gpuBytes_ -= it->second.bytes;
+        MemoryAccounting::remove(MemoryCategory::GPU_MESHES, it->second.bytes);
+        meshes_.erase(it);
+    }
+    if (chunk.getMeshIndices().empty()) return 0;
+
+    // UploadMesh only reads the CPU buffers, it does not keep them
+    std::vector<Mesh> submeshes(chunk.submeshCount());
+    for (size_t i = 0; i < submeshes.size(); i++) {
+        const Chunk::Submesh submesh = chunk.getSubmesh(i);
+        const size_t vertex = submesh.firstVertex;
+        Mesh& mesh = submeshes[i];
+        mesh.vertexCount = static_cast<int>(submesh.vertexCount);
+        mesh.triangleCount = static_cast<int>(submesh.indexCount / 3);
+        mesh.vertices = const_cast<float*>(chunk.getMeshVertices().data() + vertex * 3);
+        mesh.normals = const_cast<float*>(chunk.getMeshNormals().data() + vertex * 3);
+        mesh.texcoords = const_cast<float*>(chunk.getMeshTexcoords().data() + vertex * 2);
+        mesh.colors = const_cast<unsigned char*>(chunk.getMeshColors().data() + vertex * 4);
+        mesh.indices =
+            const_cast<unsigned short*>(chunk.getMeshIndices().data() + submesh.firstIndex);
+        UploadMesh(&mesh, false);
+
+        // The CPU buffers stay owned by the chunk, UnloadMesh must only release the GPU ones
+        mesh.vertices = mesh.normals = mesh.texcoords = nullptr;
+        mesh.colors = nullptr;
+        mesh.indices = nullptr;
+    }
+
+    const Matrix transform = MatrixTranslate(static_cast<float>(position.x * Chunk::SIZE_X),
+                                             static_cast<float>(position.y * Chunk::SIZE_Y),
+                                             static_cast<float>(position.z * Chunk::SIZE_Z));
+    const size_t bytes = chunk.meshBytes();
+    meshes_.emplace(position,
+                    GpuMesh{std::move(submeshes), transform, chunk.getCenterPosition(), bytes});
+    gpuBytes_ += bytes;
+    MemoryAccounting::add(MemoryCategory::GPU_MESHES, bytes);
+
+    return bytes;
+}
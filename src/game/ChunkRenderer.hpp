@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "common/Profiler.hpp"
+#include "common/UtilityStructures.hpp"
+#include "raylib.h"
+#include "world/Chunk.hpp"
+
+struct ChunkDrawStats {
+    size_t drawnChunks = 0;
+    size_t culledChunks = 0;  // Uploaded, but not visible
+    size_t drawnTriangles = 0;
+    double seconds = 0;  // CPU time spent culling and submitting draw calls
+};
+
+/// GPU side of the terrain: the meshes of each chunk, one per submesh, uploaded from the CPU mesh
+/// built by the terrain.
+///
+/// Keeping it out of `Chunk` lets the world be generated and meshed without a GL context.
+class ChunkRenderer {
+   public:
+    ChunkRenderer() = default;
+
+    ChunkRenderer(const ChunkRenderer&) = delete;
+    ChunkRenderer& operator=(const ChunkRenderer&) = delete;
+
+    ~ChunkRenderer();
+
+    /// Replaces the mesh of the chunk on the GPU by the last one it generated
+    ///
+    /// Returns the number of bytes uploaded
+    size_t upload(const Chunk& chunk);
+
+    /// Draws the meshes of the chunks whose center passes `isVisible(center)`
+    template <typename IsVisible>
+    void draw(const Material& material, IsVisible&& isVisible) {
+        const Clock::time_point start = Clock::now();
+        visibleMeshes_.clear();
+        {
+            PROFILE_ZONE("cull");
+            for (const GpuMesh& gpuMesh : meshes_ | std::views::values) {
+                if (isVisible(gpuMesh.center)) visibleMeshes_.push_back(&gpuMesh);
+            }
+        }
+
+        PROFILE_ZONE("draw");
+        size_t triangles = 0;
+        for (const GpuMesh* gpuMesh : visibleMeshes_) {
+            for (const Mesh& mesh : gpuMesh->submeshes) {
+                DrawMesh(mesh, material, gpuMesh->transform);
+                triangles += mesh.triangleCount;
+            }
+        }
+
+        lastDrawStats_ = {
+            .drawnChunks = visibleMeshes_.size(),
+            .culledChunks = meshes_.size() - visibleMeshes_.size(),
+            .drawnTriangles = triangles,
+            .seconds = std::chrono::duration<double>(Clock::now() - start).count(),
+        };
+    }
+
+    [[nodiscard]] size_t meshCount() const { return meshes_.size(); }
+
+    [[nodiscard]] const ChunkDrawStats& lastDrawStats() const { return lastDrawStats_; }
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct GpuMesh {
+        std::vector<Mesh> submeshes;  // See `Chunk::getSubmesh`
+        Matrix transform;
+        Vector3 center;
+        size_t bytes;
+    };
+
+    absl::flat_hash_map<Vector3Int, GpuMesh> meshes_;
+    size_t gpuBytes_ = 0;
+
+    std::vector<const GpuMesh*> visibleMeshes_;  // Scratch space of `draw`
+    ChunkDrawStats lastDrawStats_{};
+};
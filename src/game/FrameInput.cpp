@@ -0,0 +1,15 @@
+#include "FrameInput.hpp"
+
+FrameInput FrameInput::capture(const float fixedTimestep) {
+    FrameInput input{
+        .frameTime = fixedTimestep > 0 ? fixedTimestep : GetFrameTime(),
+        .mouseDelta = GetMouseDelta(),
+    };
+    for (size_t i = 0; i < INPUT_KEYS.size(); i++) {
+        const uint32_t bit = uint32_t{1} << i;
+        if (IsKeyDown(INPUT_KEYS[i])) input.keysDown |= bit;
+        if (IsKeyPressed(INPUT_KEYS[i])) input.keysPressed |= bit;
+        if (IsKeyPressedRepeat(INPUT_KEYS[i])) input.keysPressedRepeat |= bit;
+    }
+    return input;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "raylib.h"
+
+/// Keys the game reads. Their index is their bit in the `FrameInput` masks, so recordings depend
+/// on this order: append new keys and bump `InputRecorder::VERSION` when changing it.
+constexpr std::array<KeyboardKey, 17> INPUT_KEYS = {
+    // Player movement
+    KEY_W, KEY_S, KEY_A, KEY_D, KEY_SPACE, KEY_LEFT_CONTROL, KEY_LEFT_SHIFT, KEY_C,
+    // Game shortcuts
+    KEY_LEFT_ALT, KEY_KP_ADD, KEY_KP_SUBTRACT, KEY_KP_MULTIPLY, KEY_KP_DIVIDE, KEY_G, KEY_P, KEY_M,
+    KEY_F3,
+};
+
+/// Everything a frame reads from the player: the keys, the mouse motion and the frame time.
+///
+/// Reading input through it rather than from raylib lets a frame be recorded and replayed.
+struct FrameInput {
+    float frameTime = 0;  // Seconds simulated by the frame
+    Vector2 mouseDelta{};
+    uint32_t keysDown = 0;  // Bit i is INPUT_KEYS[i]
+    uint32_t keysPressed = 0;
+    uint32_t keysPressedRepeat = 0;
+
+    /// Reads the input of the current frame from raylib. With a `fixedTimestep` (in seconds),
+    /// the frame time is that instead of the measured one.
+    [[nodiscard]] static FrameInput capture(float fixedTimestep = 0);
+
+    /// Folds the input of a later frame into this one, e.g. for a simulation tick spanning several
+    /// frames: times and mouse motion add up, presses are kept and the keys down are the later ones
+    void merge(const FrameInput& later) {
+        frameTime += later.frameTime;
+        mouseDelta.x += later.mouseDelta.x;
+        mouseDelta.y += later.mouseDelta.y;
+        keysDown = later.keysDown;
+        keysPressed |= later.keysPressed;
+        keysPressedRepeat |= later.keysPressedRepeat;
+    }
+
+    [[nodiscard]] bool isKeyDown(KeyboardKey key) const { return (keysDown & keyBit(key)) != 0; }
+    [[nodiscard]] bool isKeyPressed(KeyboardKey key) const {
+        return (keysPressed & keyBit(key)) != 0;
+    }
+    [[nodiscard]] bool isKeyPressedRepeat(KeyboardKey key) const {
+        return (keysPressedRepeat & keyBit(key)) != 0;
+    }
+
+   private:
+    /// Bit of `key` in the masks, 0 for keys that are not in INPUT_KEYS
+    constexpr static uint32_t keyBit(const KeyboardKey key) {
+        for (size_t i = 0; i < INPUT_KEYS.size(); i++) {
+            if (INPUT_KEYS[i] == key) return uint32_t{1} << i;
+        }
+        return 0;
+    }
+};
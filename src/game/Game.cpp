@@ -1,21 +1,25 @@
 #include "Game.hpp"
 
+#include <cmath>
 #include <format>
-#include <iostream>
-#include <ranges>
+#include <sstream>
 
 #define RLIGHTS_IMPLEMENTATION
-#include "TextureAtlas.hpp"
+#include "common/AllocationTracker.hpp"
+#include "common/MemoryAccounting.hpp"
+#include "common/Profiler.hpp"
+#include "common/Statistics.hpp"
 #include "common/UtilityStructures.hpp"
 #include "raylib.h"
 #include "raymath.h"
 #include "rlights.h"
+#include "world/TextureAtlas.hpp"
 
-bool Game::isPositionInRenderDistance(const Vector3& position) const {
-    const float maxDistanceSq =
-        renderDistance_ * renderDistance_ * Chunk::CHUNK_SIZE * Chunk::CHUNK_SIZE;
-    return (position.x - player_.getPosition().x) * (position.x - player_.getPosition().x) +
-               (position.y - player_.getPosition().y) * (position.y - player_.getPosition().y) <
+bool Game::isPositionInRenderDistance(const Vector3& position,
+                                      const Vector3& playerPosition) const {
+    const float maxDistanceSq = renderDistance_ * renderDistance_ * Chunk::SIZE_X * Chunk::SIZE_X;
+    return (position.x - playerPosition.x) * (position.x - playerPosition.x) +
+               (position.y - playerPosition.y) * (position.y - playerPosition.y) <
            maxDistanceSq;
 }
 
@@ -37,17 +41,43 @@ void Game::drawCursor() {
     DrawCircleLinesV(center, 1.0f, BLACK);  // Draw a dot in the center
 }
 
+void Game::drawTarget(const RaycastHit& target) {
+    // Slightly larger than the block, so that its faces do not hide the outline
+    const Vector3 center = {static_cast<float>(target.block.x) + 0.5f,
+                            static_cast<float>(target.block.y) + 0.5f,
+                            static_cast<float>(target.block.z) + 0.5f};
+    DrawCubeWires(center, 1.01f, 1.01f, 1.01f, BLACK);
+}
+
 void Game::drawFps() {
     const int screenWidth = GetScreenWidth();
     const int screenHeight = GetScreenHeight();
     DrawText(TextFormat("FPS: %i", GetFPS()), screenWidth - 100, screenHeight - 30, 20, BLACK);
 }
 
-void Game::drawRenderDistance() const {
+void Game::drawRenderDistance(const SimulationSnapshot& snapshot) const {
     DrawRectangle(10, 100, 300, 60, Fade(BLACK, 0.35f));  // Semi-transparent background
     DrawRectangleLines(10, 100, 300, 60, BLACK);          // Border around the rectangle
-    DrawText(TextFormat("Render Distance: %i chunks", renderDistance_), 20, 110, 20, BLACK);
-    DrawText(TextFormat("Chunks Generated: %zu", world_.size()), 20, 130, 20, BLACK);
+    DrawText(TextFormat("Render Distance: %i chunks%s", renderDistance_,
+                        renderDistanceGovernor_.isEnabled() ? " (auto)" : ""),
+             20, 110, 20, BLACK);
+    DrawText(TextFormat("Chunks Generated: %zu", snapshot.chunkCount), 20, 130, 20, BLACK);
+}
+
+void Game::drawStreamingStats(const SimulationSnapshot& snapshot) const {
+    const ChunkPrefetchStats& prefetchStats = snapshot.prefetch;
+    const MeshUploadStats& uploadStats = meshUploadQueue_.stats();
+    DrawRectangle(10, 170, 300, 120, Fade(BLACK, 0.35f));  // Semi-transparent background
+    DrawRectangleLines(10, 170, 300, 120, BLACK);          // Border around the rectangle
+    DrawText(TextFormat("Prefetch lookahead: %.2f s", snapshot.prefetchLookahead), 20, 180, 20,
+             BLACK);
+    DrawText(TextFormat("Prefetched: %zu (%zu unused)", prefetchStats.generated,
+                        prefetchStats.unused()),
+             20, 200, 20, BLACK);
+    DrawText(TextFormat("Holes in view: %zu", prefetchStats.lastHoles), 20, 220, 20, BLACK);
+    DrawText(TextFormat("Uploads queued: %zu", uploadStats.queueDepth), 20, 240, 20, BLACK);
+    DrawText(TextFormat("Upload latency: %.1f ms", uploadStats.averageLatency * 1000.0), 20, 260,
+             20, BLACK);
 }
 
 void Game::drawPositionInfo(const Vector3& position) {
@@ -57,8 +87,8 @@ void Game::drawPositionInfo(const Vector3& position) {
              20, BLACK);
 }
 
-void Game::draw() const {
-    const Camera& camera_ = player_.getCamera();
+void Game::draw(const SimulationSnapshot& snapshot) {
+    const Camera& camera_ = snapshot.camera;
 
     SetShaderValue(terrainShader_, terrainShader_.locs[SHADER_LOC_VECTOR_VIEW], &camera_.position,
                    SHADER_UNIFORM_VEC3);
@@ -70,118 +100,66 @@ void Game::draw() const {
 
     BeginMode3D(camera_);
 
-    // const auto startTime = static_cast<float>(GetTime());
-    for (const auto& chunk : world_ | std::views::values) {
-        if (isPositionInRenderDistance(chunk->getCenterPosition())) chunk->render();
-    }
-    // const auto endTime = static_cast<float>(GetTime());
+    chunkRenderer_.draw(materialAtlas_, [&](const Vector3& center) {
+        return isPositionInRenderDistance(center, snapshot.playerPosition);
+    });
+    if (snapshot.target) drawTarget(*snapshot.target);
 
     EndMode3D();
 
     drawCursor();
     drawFps();
-    drawRenderDistance();
+    drawRenderDistance(snapshot);
+    drawStreamingStats(snapshot);
     drawPositionInfo(camera_.position);
+    if (performanceOverlay_.isVisible()) {
+        const PipelineDepths depths = {
+            .pendingGeneration = snapshot.pendingGeneration,
+            .waitingMeshing = snapshot.waitingMeshing,
+            .pendingMeshing = snapshot.pendingMeshing,
+            .pendingUploads = meshUploadQueue_.size(),
+        };
+        performanceOverlay_.draw(depths, snapshot.stats, chunkRenderer_.lastDrawStats());
+    }
 
     EndDrawing();
-
-    // std::cout << "Chunks rendering time: " << (endTime - startTime) * 1000.0f << " ms" <<
-    // std::endl;
-}
-
-std::array<OptionalRef<Chunk>, 6> Game::findAdjacentChunks(const Chunk& chunk) const {
-    std::array<OptionalRef<Chunk>, 6> adjacentChunks{};
-    const int x = chunk.getX();
-    const int y = chunk.getY();
-    const int z = chunk.getZ();
-
-    auto addAdjacentChunk = [&](const int dx, const int dy, const int dz, const size_t index) {
-        const auto it = world_.find({x + dx, y + dy, z + dz});
-        adjacentChunks[index] =
-            (it != world_.end()) ? OptionalRef<Chunk>{*it->second} : std::nullopt;
-    };
-    addAdjacentChunk(+1, 0, 0, 0);  // Positive X
-    addAdjacentChunk(-1, 0, 0, 1);  // Negative X
-    addAdjacentChunk(0, +1, 0, 2);  // Positive Y
-    addAdjacentChunk(0, -1, 0, 3);  // Negative Y
-    addAdjacentChunk(0, 0, +1, 4);  // Positive Z
-    addAdjacentChunk(0, 0, -1, 5);  // Negative Z
-
-    return adjacentChunks;
 }
 
-Chunk& Game::generateChunk(const Vector3Int& pos) {
-    auto [it, _] =
-        world_.emplace(pos, std::make_unique<Chunk>(pos.x, pos.y, pos.z, materialAtlas_));
-    it->second->generate(SEED, MAP_HEIGHT_BLOCKS);
-    return *it->second;
-};
-
-void Game::generateChunkTransforms(Chunk& chunk) const {
-    const auto adjacentChunks = findAdjacentChunks(chunk);
-    chunk.generateTransforms(adjacentChunks[0],   // Positive X
-                             adjacentChunks[1],   // Negative X
-                             adjacentChunks[2],   // Positive Y
-                             adjacentChunks[3],   // Negative Y
-                             adjacentChunks[4],   // Positive Z
-                             adjacentChunks[5]);  // Negative Z
+float Game::aspectRatio() const {
+    return static_cast<float>(GetScreenWidth()) / static_cast<float>(GetScreenHeight());
 }
 
-void Game::updateTerrain() {
-    const double startTime = GetTime();
-
-    std::unordered_set<const Chunk*> chunksToUpdateTransforms;
-
-    const auto [playerX, playerY, _] = player_.getPosition();
-    const auto playerChunkX = static_cast<int>(playerX / Chunk::CHUNK_SIZE);
-    const auto playerChunkY = static_cast<int>(playerY / Chunk::CHUNK_SIZE);
-    for (int x = -renderDistance_; x < renderDistance_; x++) {
-        const int chunkX = playerChunkX + x;
-        for (int y = -renderDistance_; y < renderDistance_; y++) {
-            const int chunkY = playerChunkY + y;
-            for (int chunkZ = 0; chunkZ < MAP_HEIGHT_BLOCKS / Chunk::CHUNK_SIZE; chunkZ++) {
-                if (!isPositionInRenderDistance(Chunk::getCenterPosition(chunkX, chunkY, chunkY))) {
-                    continue;
-                }
-
-                const Vector3Int position = {chunkX, chunkY, chunkZ};
-                if (world_.contains(position)) {
-                    continue;
-                }
-
-                Chunk& chunk = generateChunk(position);
-                chunksToUpdateTransforms.insert(&chunk);
-
-                const auto adjacentChunks = findAdjacentChunks(chunk);
-                for (const auto& adjacentChunk : adjacentChunks) {
-                    if (adjacentChunk &&
-                        isPositionInRenderDistance(adjacentChunk->get().getCenterPosition())) {
-                        chunksToUpdateTransforms.insert(&adjacentChunk->get());
-                    }
-                }
-            }
-        }
+void Game::simulate() {
+    simulation_.setRenderDistance(renderDistance_);
+    simulation_.setAspectRatio(aspectRatio());
+    if (isLockstep_) {
+        simulation_.step(input_, inputCapturedAt_);
+    } else {
+        simulation_.pushInput(input_, inputCapturedAt_);
     }
+}
 
-    std::cout << "Chunks to update transforms: " << chunksToUpdateTransforms.size() << std::endl;
-
-    const double intermediateTime = GetTime();
-    for (const auto* chunk : chunksToUpdateTransforms) {
-        generateChunkTransforms(*const_cast<Chunk*>(chunk));
-    }
+void Game::queueMeshedChunks() {
+    simulation_.drainMeshedChunks(
+        [&](const Vector3Int& position) { meshUploadQueue_.push(position); });
+}
 
-    const double endTime = GetTime();
-    std::cout << "Terrain update time: " << (endTime - startTime) * 1000.0f << " ms" << std::endl;
-    std::cout << "Chunk transforms generation time: " << (endTime - intermediateTime) * 1000.0f
-              << " ms" << std::endl;
+void Game::uploadPendingMeshes(const Vector3& playerPosition, const MeshUploadBudget& budget) {
+    // Meshes listed by the simulation are never written again, so they upload while it runs
+    const ChunkMap& chunks = simulation_.terrain().chunks();
+    const ChunkMap::ReadGuard guard = chunks.pin();
+    meshUploadQueue_.drain(playerPosition, budget, [&](const Vector3Int& position) {
+        const Chunk* chunk = chunks.find(position, guard);
+        return chunk != nullptr ? chunkRenderer_.upload(*chunk) : 0;
+    });
 }
 
 void Game::updateShader() { materialAtlas_.shader = terrainShader_; }
 
 void Game::updateFog() {
     constexpr Vector3 fogColor = {0.65f, 0.76f, 0.92f};
-    const float fogStart = renderDistance_ / 3.0f * Chunk::CHUNK_SIZE;
-    const float fogEnd = renderDistance_ * Chunk::CHUNK_SIZE;
+    const float fogStart = fogDistance_ / 3.0f * Chunk::SIZE_X;
+    const float fogEnd = fogDistance_ * Chunk::SIZE_X;
 
     const int locFogColor = GetShaderLocation(terrainShader_, "fogColor");
     const int locFogStart = GetShaderLocation(terrainShader_, "fogStart");
@@ -195,7 +173,54 @@ void Game::updateFog() {
     updateShader();
 }
 
-void Game::init() {
+void Game::updateFogDistance(const float deltaTime) {
+    constexpr float epsilon = 0.01f;  // In chunks
+
+    const auto target = static_cast<float>(renderDistance_);
+    if (fogDistance_ == target) return;
+
+    fogDistance_ += (target - fogDistance_) * std::min(FOG_TRANSITION_SPEED * deltaTime, 1.0f);
+    if (std::abs(target - fogDistance_) < epsilon) fogDistance_ = target;
+    updateFog();
+}
+
+bool Game::init() {
+    Profiler::setThreadName("main");
+
+    if (!options_.replayPath.empty()) {
+        inputReplay_.emplace();
+        if (!inputReplay_->load(options_.replayPath)) {
+            TraceLog(LOG_ERROR, "Could not read the input recording %s",
+                     options_.replayPath.c_str());
+            return false;
+        }
+        frameTimes_.reserve(inputReplay_->frameCount());
+    }
+    if (!options_.recordPath.empty()) {
+        inputRecorder_.emplace(options_.recordPath);
+        if (!inputRecorder_->isOpen()) {
+            TraceLog(LOG_ERROR, "Could not write the input recording %s",
+                     options_.recordPath.c_str());
+            return false;
+        }
+    }
+    if (!options_.frameLogPath.empty()) {
+        frameLog_.open(options_.frameLogPath);
+        if (!frameLog_) {
+            TraceLog(LOG_ERROR, "Could not write the frame log %s",
+                     options_.frameLogPath.c_str());
+            return false;
+        }
+        frameLog_ << "frame,frame_ms,terrain_ms,meshing_ms,upload_ms,draw_ms,input_latency_ms\n";
+    }
+
+    // The governor adapts the render distance to the measured frame times, which would make a
+    // recorded run and its replays stream different terrain
+    if (inputReplay_ || inputRecorder_) renderDistanceGovernor_.setEnabled(false);
+
+    // Likewise, ticks on their own thread would see the frames of a recording at other times
+    isLockstep_ = options_.lockstep || options_.fixedTimestep || inputReplay_ || inputRecorder_;
+
     DisableCursor();
     SetTargetFPS(0);  // Set to maximum FPS
 
@@ -215,55 +240,138 @@ void Game::init() {
     updateFog();
 
     const Texture2D textureAtlas = LoadTexture(TEXTURE_ATLAS_PATH.c_str());
+    // The block texture coordinates are computed at compile time for the atlas' dimensions
+    if (textureAtlas.width != TEXTURE_ATLAS_WIDTH || textureAtlas.height != TEXTURE_ATLAS_HEIGHT) {
+        TraceLog(LOG_ERROR, "The texture atlas is %dx%d, the block textures expect %dx%d",
+                 textureAtlas.width, textureAtlas.height, TEXTURE_ATLAS_WIDTH,
+                 TEXTURE_ATLAS_HEIGHT);
+        UnloadTexture(textureAtlas);
+        return false;
+    }
     materialAtlas_ = LoadMaterialDefault();
     materialAtlas_.maps[MATERIAL_MAP_DIFFUSE].color = WHITE;
     materialAtlas_.maps[MATERIAL_MAP_DIFFUSE].texture = textureAtlas;
     updateShader();
 
-    const double chunksUpperBound =
-        static_cast<float>((renderDistance_ + M_SQRT1_2) * (renderDistance_ + M_SQRT1_2)) * M_PI *
-        MAP_HEIGHT_BLOCKS / Chunk::CHUNK_SIZE;
-    world_.reserve(static_cast<size_t>(chunksUpperBound));
-
-    // Generate spawn chunks first to know the starting position for accurate render distance
-    const double startTime = GetTime();
-    for (int z = 0; z < MAP_HEIGHT_BLOCKS / Chunk::CHUNK_SIZE; z++) {
-        generateChunk({0, 0, z});
+    // Generate all the chunks within the render distance before the first frame
+    simulation_.init(renderDistance_, aspectRatio());
+    for (const Vector3Int& position : simulation_.terrain().meshedChunks()) {
+        meshUploadQueue_.push(position);
     }
+    uploadPendingMeshes(simulation_.snapshot().playerPosition, {});
+    if (!isLockstep_) simulation_.start();
+    return true;
+}
 
-    // Determine the starting position
-    int startZ = 0;
-    while (world_.at({0, 0, startZ / Chunk::CHUNK_SIZE})
-               ->getData()[0][0][startZ % Chunk::CHUNK_SIZE]
-               .type() != BlockType::BLOCK_AIR) {
-        startZ++;
+void Game::exportTrace() {
+    const std::string path = std::format("{}/trace.json", CMAKE_ROOT_DIR);
+    if (Profiler::exportChromeTrace(path)) {
+        TraceLog(LOG_INFO, "Profiler trace written to %s", path.c_str());
+    } else {
+        TraceLog(LOG_WARNING, "Could not write the profiler trace to %s", path.c_str());
     }
-    startZ += 2;                                                    // Start above the ground
-    player_.setPosition({0.5f, 0.5f, static_cast<float>(startZ)});  // Middle of the block
+}
 
-    // Generate the remaining chunks
-    updateTerrain();
+void Game::dumpMemory() {
+    std::ostringstream dump;
+    MemoryAccounting::dump(dump);
+    TraceLog(LOG_INFO, "World memory:\n%s", dump.str().c_str());
+    lastMemoryDumpTime_ = GetTime();
 }
 
 void Game::run() {
-    while (!WindowShouldClose()) {
-        player_.update();
-
-        bool updated = false;
-        if (IsKeyDown(KEY_LEFT_ALT)) {
-            if (IsKeyPressed(KEY_KP_ADD) || IsKeyPressedRepeat(KEY_KP_ADD)) {
-                renderDistance_++;
-                updated = true;
-            } else if ((IsKeyPressed(KEY_KP_SUBTRACT) || IsKeyPressedRepeat(KEY_KP_SUBTRACT)) &&
-                       renderDistance_ > 1) {
-                renderDistance_--;
-                updated = true;
-            }
+    while (!WindowShouldClose() && !(inputReplay_ && inputReplay_->isFinished())) {
+        PROFILE_ZONE("frame");
+        const AllocationCounts allocationsBefore = AllocationTracker::threadCounts();
+        readInput();
+        handleShortcuts();
+        simulate();
+
+        const SimulationSnapshot& snapshot = simulation_.snapshot();
+        queueMeshedChunks();
+        uploadPendingMeshes(snapshot.playerPosition, MESH_UPLOAD_BUDGET_PER_FRAME);
+
+        // On its own thread, the terrain does not take from the frame
+        const FrameTimings timings = {
+            .frame = GetFrameTime(),
+            .terrain = isLockstep_ ? snapshot.terrainSeconds : 0.0,
+            .upload = meshUploadQueue_.stats().lastFrameSeconds,
+        };
+        renderDistance_ = renderDistanceGovernor_.update(renderDistance_, timings);
+        updateFogDistance(input_.frameTime);
+
+        draw(snapshot);
+
+        const PerformanceSample sample = {
+            .frame = GetFrameTime(),
+            .terrain = snapshot.terrainSeconds,
+            .meshing = snapshot.meshingSeconds,
+            .upload = timings.upload,
+            .draw = chunkRenderer_.lastDrawStats().seconds,
+            .inputLatency = std::chrono::duration<double>(Simulation::Clock::now() -
+                                                          snapshot.inputCapturedAt)
+                                .count(),
+            .allocations = AllocationTracker::threadCounts() - allocationsBefore,
+        };
+        performanceOverlay_.record(sample);
+        logFrame(sample);
+    }
+
+    simulation_.stop();
+    if (inputReplay_) logFrameTimeSummary();
+}
+
+void Game::readInput() {
+    const float fixedTimestep = options_.fixedTimestep ? FIXED_TIMESTEP : 0.0f;
+    if (inputReplay_) {
+        input_ = inputReplay_->next();
+        if (fixedTimestep > 0) input_.frameTime = fixedTimestep;
+    } else {
+        input_ = FrameInput::capture(fixedTimestep);
+    }
+    inputCapturedAt_ = Simulation::Clock::now();
+    if (inputRecorder_) inputRecorder_->record(input_);
+}
+
+void Game::handleShortcuts() {
+    // Changing the render distance by hand takes it back from the governor
+    if (input_.isKeyDown(KEY_LEFT_ALT)) {
+        if (input_.isKeyPressed(KEY_KP_ADD) || input_.isKeyPressedRepeat(KEY_KP_ADD)) {
+            renderDistance_++;
+            renderDistanceGovernor_.setEnabled(false);
+        } else if ((input_.isKeyPressed(KEY_KP_SUBTRACT) ||
+                    input_.isKeyPressedRepeat(KEY_KP_SUBTRACT)) &&
+                   renderDistance_ > 1) {
+            renderDistance_--;
+            renderDistanceGovernor_.setEnabled(false);
+        } else if (input_.isKeyPressed(KEY_G) && !inputReplay_ && !inputRecorder_) {
+            // Stays off while recording or replaying, see `init`
+            renderDistanceGovernor_.setEnabled(!renderDistanceGovernor_.isEnabled());
         }
-        if (updated) updateFog();
+    }
 
-        updateTerrain();
+    if (input_.isKeyDown(KEY_LEFT_ALT) && input_.isKeyPressed(KEY_P)) exportTrace();
+    if (input_.isKeyPressed(KEY_F3)) performanceOverlay_.toggle();
+    if ((input_.isKeyDown(KEY_LEFT_ALT) && input_.isKeyPressed(KEY_M)) ||
+        GetTime() - lastMemoryDumpTime_ >= MEMORY_DUMP_INTERVAL_SECONDS) {
+        dumpMemory();
+    }
+}
 
-        draw();
+void Game::logFrame(const PerformanceSample& sample) {
+    if (inputReplay_) frameTimes_.push_back(sample.frame);
+    if (frameLog_.is_open()) {
+        frameLog_ << std::format("{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}\n", frameIndex_,
+                                 sample.frame * 1000.0, sample.terrain * 1000.0,
+                                 sample.meshing * 1000.0, sample.upload * 1000.0,
+                                 sample.draw * 1000.0, sample.inputLatency * 1000.0);
     }
-}
\ No newline at end of file
+    frameIndex_++;
+}
+
+void Game::logFrameTimeSummary() {
+    if (frameTimes_.empty()) return;
+    TraceLog(LOG_INFO, "Replayed %zu frames, frame time p50 %.3f ms, p95 %.3f ms, p99 %.3f ms",
+             frameTimes_.size(), percentile(frameTimes_, 0.50) * 1000.0,
+             percentile(frameTimes_, 0.95) * 1000.0, percentile(frameTimes_, 0.99) * 1000.0);
+}
@@ -1,54 +1,130 @@
 #pragma once
 
-#include "Chunk.hpp"
-#include "Player.hpp"
-#include "absl/container/flat_hash_map.h"
-#include "common/UtilityStructures.hpp"
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ChunkRenderer.hpp"
+#include "FrameInput.hpp"
+#include "InputRecording.hpp"
+#include "MeshUploadQueue.hpp"
+#include "PerformanceOverlay.hpp"
+#include "RenderDistanceGovernor.hpp"
+#include "Simulation.hpp"
 #include "raylib.h"
 
+struct GameOptions {
+    std::string recordPath;      // Where to record the input of every frame, if set
+    std::string replayPath;      // Recording to play instead of the live input, if set
+    bool fixedTimestep = false;  // Simulate Game::FIXED_TIMESTEP per frame, not the frame time
+    bool lockstep = false;  // Simulate once per frame on the render thread, as replays always do
+    std::string frameLogPath;    // Where to write the frame times as CSV, if set
+};
+
 class Game {
    public:
-    Game() = default;
+    /// Seconds simulated per frame with `GameOptions::fixedTimestep`
+    constexpr static float FIXED_TIMESTEP = 1.0f / 60.0f;
+
+    explicit Game(GameOptions options) : options_(std::move(options)) {}
     ~Game() { UnloadMaterial(materialAtlas_); }
 
-    void init();
+    /// Returns false if a file of the options cannot be opened
+    [[nodiscard]] bool init();
+
+    /// Runs until the window is closed, or until the end of the replayed recording
     void run();
 
    private:
     constexpr static int DEFAULT_RENDER_DISTANCE = 15;  // Render distance in chunks
+    constexpr static int MIN_RENDER_DISTANCE = 2;
+    constexpr static int MAX_AUTO_RENDER_DISTANCE = 48;
+    constexpr static float FOG_TRANSITION_SPEED = 2.0f;  // Fraction of the gap closed per second
     constexpr static int MAP_HEIGHT_BLOCKS = 512;
     constexpr static int SEED = 1;  // Seed for noise generation
+    constexpr static double MEMORY_DUMP_INTERVAL_SECONDS = 60.0;
+    constexpr static MeshUploadBudget MESH_UPLOAD_BUDGET_PER_FRAME = {
+        .maxBytes = 8 * 1024 * 1024,
+        .maxSeconds = 0.002,
+    };
+
+    const GameOptions options_;
+    FrameInput input_{};  // Of the current frame
+    Simulation::Clock::time_point inputCapturedAt_{};
+    std::optional<InputRecorder> inputRecorder_;
+    std::optional<InputReplay> inputReplay_;
+    std::ofstream frameLog_;
+    size_t frameIndex_ = 0;
+    std::vector<double> frameTimes_;  // Of a replay, summarized at its end
+
+    bool isLockstep_ = false;  // See GameOptions::lockstep
 
     int renderDistance_ = DEFAULT_RENDER_DISTANCE;
+    float fogDistance_ = DEFAULT_RENDER_DISTANCE;  // Follows renderDistance_ smoothly, in chunks
 
-    Player player_{};
+    RenderDistanceGovernor renderDistanceGovernor_{MIN_RENDER_DISTANCE, MAX_AUTO_RENDER_DISTANCE};
 
-    absl::flat_hash_map<Vector3Int, std::unique_ptr<Chunk>> world_{};
+    Simulation simulation_{SEED, MAP_HEIGHT_BLOCKS};
+    MeshUploadQueue meshUploadQueue_;
+    ChunkRenderer chunkRenderer_;
+
+    PerformanceOverlay performanceOverlay_;
+    double lastMemoryDumpTime_ = 0;
 
     Shader terrainShader_{};
     Material materialAtlas_{};
 
-    [[nodiscard]] bool isPositionInRenderDistance(const Vector3& position) const;
+    [[nodiscard]] bool isPositionInRenderDistance(const Vector3& position,
+                                                  const Vector3& playerPosition) const;
 
     static void drawSky();
     static void drawCursor();
+    /// Outlines the block the crosshair targets
+    static void drawTarget(const RaycastHit& target);
     static void drawFps();
-    void drawRenderDistance() const;
+    void drawRenderDistance(const SimulationSnapshot& snapshot) const;
+    void drawStreamingStats(const SimulationSnapshot& snapshot) const;
     static void drawPositionInfo(const Vector3& position);
-    void draw() const;
+    void draw(const SimulationSnapshot& snapshot);
+
+    [[nodiscard]] float aspectRatio() const;
 
-    [[nodiscard]] std::array<OptionalRef<Chunk>, 6> findAdjacentChunks(const Chunk& chunk) const;
+    /// Hands the input of the frame to the simulation, or runs its tick in lockstep
+    void simulate();
 
-    Chunk& generateChunk(const Vector3Int& pos);
-    void generateChunkTransforms(Chunk& chunk) const;
+    /// Queues the meshes the simulation finished for upload
+    void queueMeshedChunks();
 
-    /// If needed, updates chunk transforms and generates new chunks within the render distance
-    /// around the player
-    void updateTerrain();
+    /// Sends queued meshes to the GPU, closest to `playerPosition` first, within the given budget
+    void uploadPendingMeshes(const Vector3& playerPosition, const MeshUploadBudget& budget);
 
     /// Update the shader used in the material atlas to the current terrain shader
     ///
     /// Note: chunk transforms must be re-generated separately after changing the shader
     void updateShader();
     void updateFog();
+
+    /// Moves the fog distance towards the render distance
+    void updateFogDistance(float deltaTime);
+
+    /// Writes the profiled zones of the last frames as a Chrome trace (ALT+P)
+    static void exportTrace();
+
+    /// Logs the memory used by the world, every MEMORY_DUMP_INTERVAL_SECONDS and on ALT+M
+    void dumpMemory();
+
+    /// Reads the input of the frame, live or replayed, and records it if asked to
+    void readInput();
+
+    /// Handles the ALT shortcuts of the renderer and F3, the simulation handles its own
+    void handleShortcuts();
+
+    /// Writes the times of the frame to the frame log, if any
+    void logFrame(const PerformanceSample& sample);
+
+    /// Logs the frame time percentiles of the replay
+    void logFrameTimeSummary();
 };
\ No newline at end of file
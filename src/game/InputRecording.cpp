@@ -0,0 +1,57 @@
+#include "InputRecording.hpp"
+
+#include <bit>
+#include <cstring>
+
+// Records are written as the in-memory bytes of their fields
+static_assert(std::endian::native == std::endian::little);
+
+namespace {
+
+template <typename T>
+void write(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+}  // namespace
+
+InputRecorder::InputRecorder(const std::string& path) : out_(path, std::ios::binary) {
+    out_.write(MAGIC, sizeof(MAGIC));
+    write(out_, VERSION);
+    write(out_, static_cast<uint32_t>(INPUT_KEYS.size()));
+}
+
+void InputRecorder::record(const FrameInput& input) {
+    write(out_, input.frameTime);
+    write(out_, input.mouseDelta.x);
+    write(out_, input.mouseDelta.y);
+    write(out_, input.keysDown);
+    write(out_, input.keysPressed);
+    write(out_, input.keysPressedRepeat);
+}
+
+bool InputReplay::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(InputRecorder::MAGIC)];
+    uint32_t version = 0, keyCount = 0;
+    if (!read(in, magic) || std::memcmp(magic, InputRecorder::MAGIC, sizeof(magic)) != 0 ||
+        !read(in, version) || version != InputRecorder::VERSION || !read(in, keyCount) ||
+        keyCount != INPUT_KEYS.size()) {
+        return false;
+    }
+
+    frames_.clear();
+    next_ = 0;
+    FrameInput input;
+    while (read(in, input.frameTime) && read(in, input.mouseDelta.x) &&
+           read(in, input.mouseDelta.y) && read(in, input.keysDown) &&
+           read(in, input.keysPressed) && read(in, input.keysPressedRepeat)) {
+        frames_.push_back(input);
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "FrameInput.hpp"
+
+/// Writes the input of every frame to a file, to replay the same session with `InputReplay`.
+///
+/// The file is a header (magic, version, key count) followed by a fixed-size little-endian record
+/// per frame: frame time, mouse delta and the three key masks, 24 bytes, about 1.4 KiB per second
+/// at 60 FPS.
+class InputRecorder {
+   public:
+    constexpr static char MAGIC[8] = {'M', 'C', 'I', 'N', 'P', 'U', 'T', '\0'};
+    constexpr static uint32_t VERSION = 1;
+
+    /// Opens `path` for writing, `isOpen()` tells whether it could be created
+    explicit InputRecorder(const std::string& path);
+
+    [[nodiscard]] bool isOpen() const { return static_cast<bool>(out_); }
+
+    void record(const FrameInput& input);
+
+   private:
+    std::ofstream out_;
+};
+
+/// Feeds back the frames of a file written by `InputRecorder`, in order
+class InputReplay {
+   public:
+    /// Returns false if the file cannot be read or is not a recording of this version
+    bool load(const std::string& path);
+
+    [[nodiscard]] bool isFinished() const { return next_ >= frames_.size(); }
+
+    /// Input of the next frame, `isFinished()` must be false
+    const FrameInput& next() { return frames_[next_++]; }
+
+    [[nodiscard]] size_t frameCount() const { return frames_.size(); }
+
+   private:
+    std::vector<FrameInput> frames_;
+    size_t next_ = 0;
+};
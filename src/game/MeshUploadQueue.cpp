@@ -0,0 +1,33 @@
+#include "MeshUploadQueue.hpp"
+
+#include <algorithm>
+
+#include "world/Chunk.hpp"
+#include "raymath.h"
+
+void MeshUploadQueue::push(const Vector3Int& position) {
+    if (!queued_.insert(position).second) return;
+
+    pending_.push_back({position, Clock::now()});
+    stats_.maxQueueDepth = std::max(stats_.maxQueueDepth, pending_.size());
+}
+
+void MeshUploadQueue::sortByDistance(const Vector3& playerPosition) {
+    std::ranges::sort(pending_, std::ranges::greater{}, [&](const Pending& mesh) {
+        const Vector3 center =
+            Chunk::getCenterPosition(mesh.position.x, mesh.position.y, mesh.position.z);
+        return Vector3DistanceSqr(center, playerPosition);
+    });
+}
+
+void MeshUploadQueue::recordLatency(const double seconds) {
+    constexpr double smoothing = 0.05;
+
+    if (stats_.totalUploads == 0) {
+        stats_.averageLatency = seconds;
+    } else {
+        stats_.averageLatency += (seconds - stats_.averageLatency) * smoothing;
+    }
+    stats_.maxLatency = std::max(stats_.maxLatency, seconds);
+    stats_.totalUploads++;
+}
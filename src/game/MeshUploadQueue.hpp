@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "common/UtilityStructures.hpp"
+#include "raylib.h"
+
+/// How much uploading a single frame may do. At least one mesh is uploaded per drain so the queue
+/// always makes progress, even if that mesh alone exceeds the budget.
+struct MeshUploadBudget {
+    size_t maxBytes = std::numeric_limits<size_t>::max();
+    double maxSeconds = std::numeric_limits<double>::infinity();
+};
+
+struct MeshUploadStats {
+    size_t queueDepth = 0;         // After the last drain
+    size_t maxQueueDepth = 0;      // Highest depth ever reached
+    size_t lastFrameUploads = 0;   // Meshes uploaded by the last drain
+    size_t lastFrameBytes = 0;     // Bytes uploaded by the last drain
+    double lastFrameSeconds = 0;   // Time spent by the last drain
+    size_t totalUploads = 0;
+    double averageLatency = 0;  // Seconds between queuing and uploading, moving average
+    double maxLatency = 0;      // Seconds between queuing and uploading, worst case
+};
+
+/// Meshes waiting to be sent to the GPU, uploaded closest to the player first under a per-frame
+/// byte and time budget, so that streaming terrain in does not cause frame time spikes.
+class MeshUploadQueue {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Queues the mesh of a chunk. If it is already queued, it keeps its place and latency start.
+    void push(const Vector3Int& position);
+
+    /// Uploads queued meshes closest to `playerPosition` first until the budget is spent.
+    ///
+    /// `upload(position)` must upload the mesh of the chunk at `position` and return the number of
+    /// bytes sent, or 0 if there is nothing to upload anymore
+    template <typename Upload>
+    void drain(const Vector3& playerPosition, const MeshUploadBudget& budget, Upload&& upload) {
+        const Clock::time_point start = Clock::now();
+        stats_.lastFrameUploads = 0;
+        stats_.lastFrameBytes = 0;
+
+        if (!pending_.empty()) {
+            sortByDistance(playerPosition);
+
+            while (!pending_.empty()) {
+                const Clock::time_point now = Clock::now();
+                const double elapsed = std::chrono::duration<double>(now - start).count();
+                if (stats_.lastFrameUploads > 0 &&
+                    (stats_.lastFrameBytes >= budget.maxBytes || elapsed >= budget.maxSeconds)) {
+                    break;
+                }
+
+                const Pending mesh = pending_.back();
+                pending_.pop_back();
+                queued_.erase(mesh.position);
+
+                const size_t bytes = upload(mesh.position);
+                if (bytes == 0) continue;
+
+                stats_.lastFrameUploads++;
+                stats_.lastFrameBytes += bytes;
+                recordLatency(std::chrono::duration<double>(Clock::now() - mesh.queuedAt).count());
+            }
+        }
+
+        stats_.queueDepth = pending_.size();
+        stats_.lastFrameSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    [[nodiscard]] size_t size() const { return pending_.size(); }
+    [[nodiscard]] bool empty() const { return pending_.empty(); }
+    [[nodiscard]] const MeshUploadStats& stats() const { return stats_; }
+
+   private:
+    struct Pending {
+        Vector3Int position;
+        Clock::time_point queuedAt;
+    };
+
+    std::vector<Pending> pending_;  // Sorted farthest first by the last drain
+    absl::flat_hash_set<Vector3Int> queued_;
+
+    MeshUploadStats stats_{};
+
+    void sortByDistance(const Vector3& playerPosition);
+    void recordLatency(double seconds);
+};
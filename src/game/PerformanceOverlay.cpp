@@ -0,0 +1,97 @@
+#include "PerformanceOverlay.hpp"
+
+#include <algorithm>
+
+#include "common/MemoryAccounting.hpp"
+#include "raylib.h"
+
+namespace {
+
+double toMebibytes(const size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+}  // namespace
+
+void PerformanceOverlay::record(const PerformanceSample& sample) {
+    graphs_[0].history.push(sample.frame);
+    graphs_[1].history.push(sample.terrain);
+    graphs_[2].history.push(sample.meshing);
+    graphs_[3].history.push(sample.upload);
+    graphs_[4].history.push(sample.draw);
+    graphs_[5].history.push(sample.inputLatency);
+    lastAllocations_ = sample.allocations;
+}
+
+void PerformanceOverlay::drawGraph(const Graph& graph, const int x, const int y) {
+    const SampleHistory& history = graph.history;
+    const double p50 = history.percentile(0.50);
+    const double p95 = history.percentile(0.95);
+    const double p99 = history.percentile(0.99);
+    DrawText(TextFormat("%s  p50 %.2f  p95 %.2f  p99 %.2f ms", graph.name, p50 * 1000.0,
+                        p95 * 1000.0, p99 * 1000.0),
+             x, y, FONT_SIZE, WHITE);
+
+    // Scaled so that the p99 sits at 80% of the height, spikes above it are clipped
+    const int graphY = y + LINE_HEIGHT;
+    const double scale = GRAPH_HEIGHT * 0.8 / std::max(p99, 1e-4);
+    const float barWidth = static_cast<float>(PANEL_WIDTH - 2 * MARGIN) / HISTORY_FRAMES;
+    DrawRectangle(x, graphY, PANEL_WIDTH - 2 * MARGIN, GRAPH_HEIGHT, Fade(BLACK, 0.35f));
+    for (size_t i = 0; i < history.size(); i++) {
+        const double sample = history[i];
+        const auto height = static_cast<float>(std::min(sample * scale, double{GRAPH_HEIGHT}));
+        const Vector2 position = {static_cast<float>(x) + static_cast<float>(i) * barWidth,
+                                  static_cast<float>(graphY + GRAPH_HEIGHT) - height};
+        DrawRectangleV(position, {barWidth, height}, sample > p95 ? RED : LIME);
+    }
+}
+
+void PerformanceOverlay::draw(const PipelineDepths& depths, const SimulationStats& simulationStats,
+                              const ChunkDrawStats& drawStats) const {
+    if (!isVisible_) return;
+
+    const int panelX = GetScreenWidth() - PANEL_WIDTH - MARGIN;
+    const int x = panelX + MARGIN;
+    int y = 2 * MARGIN;
+
+    constexpr int allocationLines = AllocationTracker::IS_ENABLED ? 1 : 0;
+    constexpr int textLines = 6 + MEMORY_CATEGORY_COUNT + 1 + allocationLines;
+    const int panelHeight = static_cast<int>(graphs_.size()) * GRAPH_ROW_HEIGHT +
+                            textLines * LINE_HEIGHT + 2 * MARGIN;
+    DrawRectangle(panelX, MARGIN, PANEL_WIDTH, panelHeight, Fade(BLACK, 0.6f));
+
+    for (const Graph& graph : graphs_) {
+        drawGraph(graph, x, y);
+        y += GRAPH_ROW_HEIGHT;
+    }
+
+    auto drawLine = [&](const char* text) {
+        DrawText(text, x, y, FONT_SIZE, WHITE);
+        y += LINE_HEIGHT;
+    };
+    drawLine(TextFormat("Simulation ticks: %llu (%llu late, %llu dropped), last %.2f ms",
+                        static_cast<unsigned long long>(simulationStats.ticks),
+                        static_cast<unsigned long long>(simulationStats.lateTicks),
+                        static_cast<unsigned long long>(simulationStats.droppedTicks),
+                        simulationStats.lastTickSeconds * 1000.0));
+    drawLine(TextFormat("Queued generation: %zu", depths.pendingGeneration));
+    drawLine(TextFormat("Queued meshing: %zu (%zu waiting for neighbours)", depths.pendingMeshing,
+                        depths.waitingMeshing));
+    drawLine(TextFormat("Queued uploads: %zu", depths.pendingUploads));
+    drawLine(TextFormat("Chunks drawn: %zu, culled: %zu", drawStats.drawnChunks,
+                        drawStats.culledChunks));
+    drawLine(TextFormat("Triangles: %zu", drawStats.drawnTriangles));
+    for (const MemoryCategory category : MEMORY_CATEGORIES) {
+        const size_t budget = MemoryAccounting::budget(category);
+        drawLine(budget == MemoryAccounting::NO_BUDGET
+                     ? TextFormat("%s: %.1f MiB", MemoryAccounting::name(category),
+                                  toMebibytes(MemoryAccounting::bytes(category)))
+                     : TextFormat("%s: %.1f / %.1f MiB", MemoryAccounting::name(category),
+                                  toMebibytes(MemoryAccounting::bytes(category)),
+                                  toMebibytes(budget)));
+    }
+    drawLine(TextFormat("Total: %.1f MiB", toMebibytes(MemoryAccounting::totalBytes())));
+    if constexpr (AllocationTracker::IS_ENABLED) {
+        drawLine(TextFormat("Allocations: %llu, %llu bytes",
+                            static_cast<unsigned long long>(lastAllocations_.allocations),
+                            static_cast<unsigned long long>(lastAllocations_.bytes)));
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "ChunkRenderer.hpp"
+#include "Simulation.hpp"
+#include "common/AllocationTracker.hpp"
+#include "common/SampleHistory.hpp"
+
+/// Time spent by the subsystems during a frame, in seconds, and the frame's heap allocations
+struct PerformanceSample {
+    double frame = 0;
+    double terrain = 0;  // Whole terrain update, meshing included
+    double meshing = 0;
+    double upload = 0;
+    double draw = 0;          // CPU side: culling and draw calls
+    double inputLatency = 0;  // From reading an input to presenting the frame of its tick
+    AllocationCounts allocations{};  // Of the main thread, only tracked in some builds
+};
+
+struct PipelineDepths {
+    size_t pendingGeneration = 0;
+    size_t waitingMeshing = 0;  // Mesh jobs waiting for the generation of their neighbourhood
+    size_t pendingMeshing = 0;
+    size_t pendingUploads = 0;
+};
+
+/// Toggleable overlay with per-subsystem frame time and input latency graphs and percentiles, the
+/// simulation's ticks, the chunk pipeline queue depths, the culling results and the memory used by
+/// the world (see `MemoryAccounting`).
+/// Builds that track allocations also show those of the last frame.
+class PerformanceOverlay {
+   public:
+    constexpr static size_t HISTORY_FRAMES = 240;
+
+    void toggle() { isVisible_ = !isVisible_; }
+    [[nodiscard]] bool isVisible() const { return isVisible_; }
+
+    /// Samples are recorded even while hidden, so that the graphs are full when shown
+    void record(const PerformanceSample& sample);
+
+    void draw(const PipelineDepths& depths, const SimulationStats& simulationStats,
+              const ChunkDrawStats& drawStats) const;
+
+   private:
+    constexpr static int PANEL_WIDTH = 420;
+    constexpr static int MARGIN = 10;
+    constexpr static int GRAPH_HEIGHT = 40;
+    constexpr static int FONT_SIZE = 20;
+    constexpr static int LINE_HEIGHT = 22;
+    constexpr static int GRAPH_ROW_HEIGHT = LINE_HEIGHT + GRAPH_HEIGHT + MARGIN;
+
+    struct Graph {
+        const char* name;
+        SampleHistory history{HISTORY_FRAMES};
+    };
+
+    bool isVisible_ = false;
+    AllocationCounts lastAllocations_{};
+
+    std::array<Graph, 6> graphs_{{
+        {"Frame"},
+        {"Terrain update"},
+        {"Meshing"},
+        {"Upload"},
+        {"Draw"},
+        {"Input latency"},
+    }};
+
+    /// Draws the graph with its percentiles at (x, y), over GRAPH_ROW_HEIGHT pixels
+    static void drawGraph(const Graph& graph, int x, int y);
+};
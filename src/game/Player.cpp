@@ -4,15 +4,15 @@
 #include "raylib.h"
 #include "raymath.h"
 
-void Player::update() {
-    updatePosition();
-    updateCamera();
+void Player::update(const FrameInput& input) {
+    updatePosition(input);
+    updateCamera(input);
 }
 
-void Player::updatePosition() {
-    const float deltaTime = GetFrameTime();
+void Player::updatePosition(const FrameInput& input) {
+    const float deltaTime = input.frameTime;
 
-    if (IsKeyPressed(keybinds_.runModeToggle)) {
+    if (input.isKeyPressed(keybinds_.runModeToggle)) {
         if (movementMode_ == MovementMode::WALKING) {
             movementMode_ = MovementMode::RUNNING;
         } else if (movementMode_ == MovementMode::RUNNING) {
@@ -28,26 +28,35 @@ void Player::updatePosition() {
     const float movementDistance = deltaTime * movementSpeed;
 
     Vector2 movement2DRelative = {
-        static_cast<float>(IsKeyDown(keybinds_.right) - IsKeyDown(keybinds_.left)),
-        static_cast<float>(IsKeyDown(keybinds_.forward) - IsKeyDown(keybinds_.backward))};
+        static_cast<float>(input.isKeyDown(keybinds_.right) - input.isKeyDown(keybinds_.left)),
+        static_cast<float>(input.isKeyDown(keybinds_.forward) -
+                           input.isKeyDown(keybinds_.backward))};
     movement2DRelative = Vector2Scale(Vector2Normalize(movement2DRelative), movementDistance);
     const Vector2 movement2D = Vector2Rotate(movement2DRelative, cameraYaw_);
     position_.x += movement2D.x;
     position_.y += movement2D.y;
 
     float verticalMovementDirection = 0.0f;
-    if (IsKeyDown(keybinds_.jump))
+    if (input.isKeyDown(keybinds_.jump))
         verticalMovementDirection = 1.0f;
-    else if (IsKeyDown(keybinds_.crouch))
+    else if (input.isKeyDown(keybinds_.crouch))
         verticalMovementDirection = -1.0f;
-    position_.z += verticalMovementDirection * movementDistance * verticalSpeedMultiplier_;
+    const float verticalMovement =
+        verticalMovementDirection * movementDistance * verticalSpeedMultiplier_;
+    position_.z += verticalMovement;
+
+    velocity_ = deltaTime > 0.0f ? Vector3Scale({movement2D.x, movement2D.y, verticalMovement},
+                                                1.0f / deltaTime)
+                                 : Vector3Zero();
 }
 
-void Player::updateCamera() {
+void Player::updateCamera(const FrameInput& input) {
     camera_.position = position_;
 
-    const Vector2 mouseDelta = GetMouseDelta();
+    const Vector2 mouseDelta = input.mouseDelta;
+    const float deltaTime = input.frameTime;
     cameraYaw_ -= mouseDelta.x * cameraSensitivity_;
+    cameraYawRate_ = deltaTime > 0.0f ? -mouseDelta.x * cameraSensitivity_ / deltaTime : 0.0f;
     cameraPitch_ -= mouseDelta.y * cameraSensitivity_;
     cameraPitch_ = Clamp(cameraPitch_, -89.0f / 180.0f * M_PI,
                          89.0f / 180.0f * M_PI);  // Limit pitch to avoid flipping
@@ -59,5 +68,5 @@ void Player::updateCamera() {
     };
     camera_.target = Vector3Add(camera_.position, direction);
 
-    camera_.fovy = IsKeyDown(keybinds_.zoomIn) ? cameraFovZoom_ : cameraFov_;
+    camera_.fovy = input.isKeyDown(keybinds_.zoomIn) ? cameraFovZoom_ : cameraFov_;
 }
\ No newline at end of file
@@ -1,15 +1,17 @@
 #pragma once
+#include "FrameInput.hpp"
 #include "raylib.h"
+#include "raymath.h"
 
 struct Keybinds {
-    int forward;
-    int backward;
-    int left;
-    int right;
-    int jump;
-    int crouch;
-    int runModeToggle;
-    int zoomIn;
+    KeyboardKey forward;
+    KeyboardKey backward;
+    KeyboardKey left;
+    KeyboardKey right;
+    KeyboardKey jump;
+    KeyboardKey crouch;
+    KeyboardKey runModeToggle;
+    KeyboardKey zoomIn;
 };
 
 class Player {
@@ -24,11 +26,17 @@ class Player {
         };
     }
 
-    void update();
+    void update(const FrameInput& input);
 
-    void setPosition(const Vector3& position) { position_ = position; }
+    void setPosition(const Vector3& position) {
+        camera_.target = Vector3Add(position, Vector3Subtract(camera_.target, camera_.position));
+        camera_.position = position;
+        position_ = position;
+    }
 
     [[nodiscard]] const Vector3& getPosition() const { return position_; }
+    [[nodiscard]] const Vector3& getVelocity() const { return velocity_; }  // Blocks per second
+    [[nodiscard]] float getYawRate() const { return cameraYawRate_; }      // Radians per second
     [[nodiscard]] const Camera& getCamera() const { return camera_; }
 
    private:
@@ -50,6 +58,7 @@ class Player {
 
     float cameraYaw_ = 0.0f;
     float cameraPitch_ = 0.0f;
+    float cameraYawRate_ = 0.0f;
 
     constexpr static Keybinds keybinds_{
         .forward = KEY_W,
@@ -64,7 +73,8 @@ class Player {
 
     Camera camera_{};
     Vector3 position_{};
+    Vector3 velocity_{};
 
-    void updatePosition();
-    void updateCamera();
+    void updatePosition(const FrameInput& input);
+    void updateCamera(const FrameInput& input);
 };
@@ -0,0 +1,47 @@
+#include "RenderDistanceGovernor.hpp"
+
+#include <algorithm>
+
+void RenderDistanceGovernor::setEnabled(const bool enabled) {
+    if (enabled && !isEnabled_) {
+        // Start from scratch, the previous averages may come from a different render distance
+        averageFrame_ = averageTerrain_ = averageUpload_ = 0;
+        cooldown_ = COOLDOWN_SECONDS;
+    }
+    isEnabled_ = enabled;
+}
+
+int RenderDistanceGovernor::update(const int renderDistance, const FrameTimings& timings) {
+    if (!isEnabled_) return renderDistance;
+
+    auto smooth = [](double& average, const double sample) {
+        average = average == 0 ? sample : average + (sample - average) * SMOOTHING;
+    };
+    smooth(averageFrame_, timings.frame);
+    smooth(averageTerrain_, timings.terrain);
+    smooth(averageUpload_, timings.upload);
+
+    if (cooldown_ > 0) {
+        cooldown_ -= timings.frame;
+        return renderDistance;
+    }
+
+    int newRenderDistance = renderDistance;
+    if (averageFrame_ > targetFrameTime_ * (1 + SHRINK_MARGIN)) {
+        newRenderDistance = renderDistance - 1;
+    } else {
+        // Drawing scales with the area within the render distance, streaming does not
+        const double streaming = averageTerrain_ + averageUpload_;
+        const double drawing = std::max(averageFrame_ - streaming, 0.0);
+        const double growth = static_cast<double>((renderDistance + 1) * (renderDistance + 1)) /
+                              static_cast<double>(renderDistance * renderDistance);
+        const double predictedFrame = drawing * growth + streaming;
+        if (predictedFrame < targetFrameTime_ * (1 - GROW_MARGIN)) {
+            newRenderDistance = renderDistance + 1;
+        }
+    }
+
+    newRenderDistance = std::clamp(newRenderDistance, minDistance_, maxDistance_);
+    if (newRenderDistance != renderDistance) cooldown_ = COOLDOWN_SECONDS;
+    return newRenderDistance;
+}
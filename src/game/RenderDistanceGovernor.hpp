@@ -0,0 +1,52 @@
+#pragma once
+
+/// Time spent during a frame, in seconds
+struct FrameTimings {
+    double frame = 0;    // Whole frame, as measured between two frames
+    double terrain = 0;  // Chunk generation and transforms generation
+    double upload = 0;   // Mesh uploads to the GPU
+};
+
+/// Adjusts the render distance so that frames take about a target duration.
+///
+/// Frame, terrain and upload times are smoothed, then the distance shrinks by one chunk when frames
+/// are clearly too slow, and grows by one chunk when the frame time predicted for the larger
+/// distance still fits comfortably in the target. Every change is followed by a cooldown, so that
+/// the generation burst caused by a larger distance is not mistaken for a steady cost.
+class RenderDistanceGovernor {
+   public:
+    constexpr static double DEFAULT_TARGET_FRAME_TIME = 1.0 / 120.0;
+
+    RenderDistanceGovernor(const int minDistance, const int maxDistance,
+                           const double targetFrameTime = DEFAULT_TARGET_FRAME_TIME)
+        : minDistance_(minDistance), maxDistance_(maxDistance), targetFrameTime_(targetFrameTime) {}
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const { return isEnabled_; }
+
+    void setTargetFrameTime(const double seconds) { targetFrameTime_ = seconds; }
+    [[nodiscard]] double targetFrameTime() const { return targetFrameTime_; }
+
+    /// Smoothed frame time, in seconds
+    [[nodiscard]] double averageFrameTime() const { return averageFrame_; }
+
+    /// Feeds the timings of the last frame and returns the render distance to use from now on
+    [[nodiscard]] int update(int renderDistance, const FrameTimings& timings);
+
+   private:
+    constexpr static double SMOOTHING = 0.05;     // Weight of the last frame in the averages
+    constexpr static double SHRINK_MARGIN = 0.1;  // Shrink above target * (1 + margin)
+    constexpr static double GROW_MARGIN = 0.2;    // Grow if predicted below target * (1 - margin)
+    constexpr static double COOLDOWN_SECONDS = 1.0;
+
+    const int minDistance_;
+    const int maxDistance_;
+    double targetFrameTime_;
+
+    bool isEnabled_ = false;
+
+    double averageFrame_ = 0;
+    double averageTerrain_ = 0;
+    double averageUpload_ = 0;
+    double cooldown_ = 0;
+};
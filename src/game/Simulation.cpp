@@ -0,0 +1,184 @@
+#include "Simulation.hpp"
+
+#include <cstddef>
+#include <utility>
+
+#include "common/Profiler.hpp"
+#include "raymath.h"
+
+namespace {
+
+/// The input of the ticks after the first one of a catch-up: the keys stay down, but the presses
+/// and the mouse motion were applied once already
+FrameInput heldKeys(const FrameInput& input) { return {.keysDown = input.keysDown}; }
+
+double secondsSince(const Simulation::Clock::time_point start) {
+    return std::chrono::duration<double>(Simulation::Clock::now() - start).count();
+}
+
+}  // namespace
+
+Simulation::Simulation(const int seed, const int mapHeightBlocks)
+    : terrain_(seed, mapHeightBlocks) {
+    unsentMeshedChunks_.reserve(MESHED_QUEUE_CAPACITY);
+}
+
+void Simulation::init(const int renderDistance, const float aspectRatio) {
+    setRenderDistance(renderDistance);
+    setAspectRatio(aspectRatio);
+
+    // Generate spawn chunks first to know the starting position for accurate render distance
+    const int startZ = terrain_.generateSpawnColumn(0, 0) + 2;      // Start above the ground
+    player_.setPosition({0.5f, 0.5f, static_cast<float>(startZ)});  // Middle of the block
+
+    const Clock::time_point start = Clock::now();
+    terrain_.fill(terrainViewer(), renderDistance);
+    publishSnapshot(secondsSince(start));
+}
+
+void Simulation::start() {
+    if (isRunning()) return;
+    thread_ = std::jthread([this](const std::stop_token& stopToken) { run(stopToken); });
+}
+
+void Simulation::stop() {
+    if (!isRunning()) return;
+    thread_.request_stop();
+    thread_.join();
+}
+
+void Simulation::step(const FrameInput& input, const Clock::time_point capturedAt) {
+    lastInputCapturedAt_ = capturedAt;
+    tick(input, 1, input.frameTime);
+}
+
+void Simulation::pushInput(const FrameInput& input, const Clock::time_point capturedAt) {
+    // A frame whose input does not fit is folded into the next one rather than lost
+    if (unsentInput_) {
+        unsentInput_->input.merge(input);
+        unsentInput_->capturedAt = capturedAt;
+    } else {
+        unsentInput_ = {input, capturedAt};
+    }
+    if (inputs_.tryPush(std::move(*unsentInput_))) unsentInput_.reset();
+}
+
+TerrainViewer Simulation::terrainViewer() const {
+    return {
+        .camera = player_.getCamera(),
+        .velocity = player_.getVelocity(),
+        .yawRate = player_.getYawRate(),
+        .aspectRatio = aspectRatio_.load(std::memory_order_relaxed),
+    };
+}
+
+void Simulation::run(const std::stop_token& stopToken) {
+    Profiler::setThreadName("simulation");
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(TICK_SECONDS));
+
+    Clock::time_point nextTick = Clock::now();
+    while (!stopToken.stop_requested()) {
+        std::this_thread::sleep_until(nextTick);
+
+        // Ticks missed while the last ones ran long are caught up, up to a point
+        const Clock::time_point now = Clock::now();
+        int steps = 1 + static_cast<int>((now - nextTick) / tickDuration);
+        if (steps > MAX_CATCH_UP_TICKS) {
+            stats_.droppedTicks += steps - MAX_CATCH_UP_TICKS;
+            steps = MAX_CATCH_UP_TICKS;
+            nextTick = now + tickDuration;
+        } else {
+            nextTick += steps * tickDuration;
+        }
+        stats_.lateTicks += steps - 1;
+
+        // Every frame since the last tick is applied at once, or the keys held if there was none
+        FrameInput input = heldKeys(lastInput_);
+        bool hasInput = false;
+        inputs_.drain([&](TimedInput&& timedInput) {
+            if (hasInput) {
+                input.merge(timedInput.input);
+            } else {
+                input = timedInput.input;
+                hasInput = true;
+            }
+            lastInputCapturedAt_ = timedInput.capturedAt;
+        });
+        lastInput_ = input;
+
+        tick(input, steps, static_cast<float>(TICK_SECONDS));
+    }
+}
+
+void Simulation::tick(const FrameInput& input, const int steps, const float deltaTime) {
+    PROFILE_ZONE("tick");
+    const Clock::time_point start = Clock::now();
+    handleShortcuts(input);
+
+    for (int i = 0; i < steps; i++) {
+        FrameInput stepInput = i == 0 ? input : heldKeys(input);
+        stepInput.frameTime = deltaTime;
+        player_.update(stepInput);
+    }
+    stats_.ticks += steps;
+
+    const Clock::time_point terrainStart = Clock::now();
+    {
+        PROFILE_ZONE("terrain");
+        terrain_.update(terrainViewer(), renderDistance_.load(std::memory_order_relaxed));
+    }
+    const double terrainSeconds = secondsSince(terrainStart);
+
+    unsentMeshedChunks_.insert(unsentMeshedChunks_.end(), terrain_.meshedChunks().begin(),
+                               terrain_.meshedChunks().end());
+    sendMeshedChunks();
+
+    stats_.lastTickSeconds = secondsSince(start);
+    publishSnapshot(terrainSeconds);
+}
+
+void Simulation::handleShortcuts(const FrameInput& input) {
+    if (input.isKeyDown(KEY_LEFT_ALT)) {
+        ChunkPrefetcher& prefetcher = terrain_.prefetcher();
+        if (input.isKeyPressed(KEY_KP_MULTIPLY)) {
+            prefetcher.setLookahead(prefetcher.lookahead() + PREFETCH_LOOKAHEAD_STEP);
+        } else if (input.isKeyPressed(KEY_KP_DIVIDE)) {
+            prefetcher.setLookahead(prefetcher.lookahead() - PREFETCH_LOOKAHEAD_STEP);
+        }
+    }
+}
+
+void Simulation::sendMeshedChunks() {
+    // Meshes that do not fit wait for the next tick, in order
+    size_t sent = 0;
+    while (sent < unsentMeshedChunks_.size() &&
+           meshedChunks_.tryPush(Vector3Int{unsentMeshedChunks_[sent]})) {
+        sent++;
+    }
+    unsentMeshedChunks_.erase(unsentMeshedChunks_.begin(),
+                              unsentMeshedChunks_.begin() + static_cast<std::ptrdiff_t>(sent));
+}
+
+void Simulation::publishSnapshot(const double terrainSeconds) {
+    const Camera& camera = player_.getCamera();
+    SimulationSnapshot& snapshot = snapshots_.back();
+    snapshot = {
+        .tick = stats_.ticks,
+        .camera = camera,
+        .playerPosition = player_.getPosition(),
+        .target = raycast(terrain_.chunks(), camera.position,
+                          Vector3Subtract(camera.target, camera.position), REACH_BLOCKS),
+        .inputCapturedAt = lastInputCapturedAt_,
+        .chunkCount = terrain_.chunks().size(),
+        .pendingGeneration = terrain_.pendingGenerationCount(),
+        .waitingMeshing = terrain_.taskGraph().waitingMeshCount(),
+        .pendingMeshing = terrain_.pendingTransformsCount(),
+        .prefetchLookahead = terrain_.prefetcher().lookahead(),
+        .prefetch = terrain_.prefetcher().stats(),
+        .terrainSeconds = terrainSeconds,
+        .meshingSeconds = terrain_.stats().lastMeshingSeconds,
+        .stats = stats_,
+    };
+    snapshots_.publish();
+}
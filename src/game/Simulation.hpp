@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "FrameInput.hpp"
+#include "Player.hpp"
+#include "common/CompletionQueue.hpp"
+#include "common/SnapshotBuffer.hpp"
+#include "world/Raycast.hpp"
+#include "world/Terrain.hpp"
+#include "raylib.h"
+
+struct SimulationStats {
+    uint64_t ticks = 0;
+    uint64_t lateTicks = 0;     // Ticks run behind schedule to catch up
+    uint64_t droppedTicks = 0;  // Ticks skipped when too far behind to catch up
+    double lastTickSeconds = 0;
+};
+
+/// What the renderer needs from a simulation tick, copied out at the end of the tick
+struct SimulationSnapshot {
+    uint64_t tick = 0;
+    Camera camera{};
+    Vector3 playerPosition{};
+    std::optional<RaycastHit> target;  // The block under the crosshair, within reach
+
+    /// When the newest input applied by the tick was captured, to measure the input latency
+    std::chrono::steady_clock::time_point inputCapturedAt{};
+
+    // Terrain state, for the overlays
+    size_t chunkCount = 0;
+    size_t pendingGeneration = 0;
+    size_t waitingMeshing = 0;
+    size_t pendingMeshing = 0;
+    float prefetchLookahead = 0;
+    ChunkPrefetchStats prefetch{};
+    double terrainSeconds = 0;  // Last terrain update, meshing included
+    double meshingSeconds = 0;
+
+    SimulationStats stats{};
+};
+
+/// The player and the terrain, updated at a fixed tick rate on their own thread so that terrain
+/// work never lengthens a frame.
+///
+/// The renderer hands the input of every frame over with `pushInput`, reads the newest state
+/// through `snapshot` and takes the chunks whose mesh is ready with `drainMeshedChunks`, whose
+/// meshes are not written again once listed. It looks chunks up through `terrain().chunks()` with
+/// a `ChunkMap::ReadGuard`. Runs that must be reproducible instead call `step` once per frame on
+/// the render thread, without starting the thread.
+class Simulation {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    constexpr static double TICK_SECONDS = 1.0 / 120.0;
+    constexpr static int MAX_CATCH_UP_TICKS = 4;  // Beyond that many ticks late, ticks are dropped
+    constexpr static float REACH_BLOCKS = 8.0f;   // How far the crosshair targets blocks
+
+    Simulation(int seed, int mapHeightBlocks);
+    ~Simulation() { stop(); }
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    /// Generates and meshes the terrain within the render distance around the spawn, before the
+    /// first frame
+    void init(int renderDistance, float aspectRatio);
+
+    /// Starts ticking on a thread of its own, until `stop`
+    void start();
+    void stop();
+    [[nodiscard]] bool isRunning() const { return thread_.joinable(); }
+
+    /// Runs a tick simulating `input.frameTime` on the calling thread, without the thread
+    void step(const FrameInput& input, Clock::time_point capturedAt);
+
+    /// Render thread: queues the input of a frame for the next tick
+    void pushInput(const FrameInput& input, Clock::time_point capturedAt);
+
+    /// Render thread: the state of the newest tick, valid until the next call
+    [[nodiscard]] const SimulationSnapshot& snapshot() { return snapshots_.acquire(); }
+
+    /// Render thread: calls `function(position)` for each chunk whose mesh became ready
+    template <typename Function>
+    void drainMeshedChunks(Function&& function) {
+        meshedChunks_.drain([&](Vector3Int&& position) { function(position); });
+    }
+
+    /// Render thread: the render distance and aspect ratio the terrain is streamed for
+    void setRenderDistance(const int chunks) {
+        renderDistance_.store(chunks, std::memory_order_relaxed);
+    }
+    void setAspectRatio(const float aspectRatio) {
+        aspectRatio_.store(aspectRatio, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const Terrain& terrain() const { return terrain_; }
+
+   private:
+    struct TimedInput {
+        FrameInput input;
+        Clock::time_point capturedAt;
+    };
+
+    constexpr static size_t INPUT_QUEUE_CAPACITY = 256;
+    constexpr static size_t MESHED_QUEUE_CAPACITY = 4096;
+    constexpr static float PREFETCH_LOOKAHEAD_STEP = 0.25f;  // In seconds
+
+    Player player_{};
+    Terrain terrain_;
+
+    std::atomic<int> renderDistance_ = 0;
+    std::atomic<float> aspectRatio_ = 1.0f;
+
+    std::jthread thread_;
+
+    SpscCompletionQueue<TimedInput, INPUT_QUEUE_CAPACITY> inputs_;
+    std::optional<TimedInput> unsentInput_;  // Render thread's, when the input queue was full
+    FrameInput lastInput_{};                 // Simulation thread's
+    Clock::time_point lastInputCapturedAt_{};
+
+    SpscCompletionQueue<Vector3Int, MESHED_QUEUE_CAPACITY> meshedChunks_;
+    std::vector<Vector3Int> unsentMeshedChunks_;  // Simulation thread's, when the queue was full
+
+    SnapshotBuffer<SimulationSnapshot> snapshots_;
+    SimulationStats stats_{};
+
+    [[nodiscard]] TerrainViewer terrainViewer() const;
+
+    void run(const std::stop_token& stopToken);
+
+    /// Advances the player by `steps` ticks of `deltaTime`, the input applying to the first one,
+    /// then updates the terrain once
+    void tick(const FrameInput& input, int steps, float deltaTime);
+
+    /// Handles the ALT shortcuts of the terrain
+    void handleShortcuts(const FrameInput& input);
+
+    void sendMeshedChunks();
+    void publishSnapshot(double terrainSeconds);
+};
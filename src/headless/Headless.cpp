@@ -0,0 +1,376 @@
+#include "Headless.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/AllocationTracker.hpp"
+#include "common/MemoryAccounting.hpp"
+#include "common/PerfBaseline.hpp"
+#include "common/Profiler.hpp"
+#include "common/Statistics.hpp"
+#include "world/HeightMap.hpp"
+#include "world/Terrain.hpp"
+#include "raymath.h"
+
+namespace {
+
+struct HeadlessOptions {
+    int seed = 1;
+    int renderDistance = 12;
+    int frames = 1800;
+    float speed = 50.0f;    // Blocks per second, the player's super running speed
+    std::string tracePath;  // Where to write the profiler trace, if set
+
+    std::string baselinePath;                 // Baseline to compare the metrics to, if set
+    std::string writeBaselinePath;            // Where to write the metrics as a baseline, if set
+    std::optional<double> toleranceOverride;  // Replaces the tolerances of the baseline
+    int throughputFills = 0;  // Fills timed for the throughput metrics, which are left out if 0
+};
+
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+constexpr float FRAME_TIME = 1.0f / 60.0f;  // Fixed timestep of the simulated frames
+constexpr float TURN_RATE = 0.5f;           // Radians per second, while turning
+constexpr float CAMERA_HEIGHT_ABOVE_GROUND = 30.0f;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename T>
+bool parseValue(const std::string_view text, T& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+/// Parses CATEGORY=MIB and sets the budget of the category
+bool parseMemoryBudget(const std::string_view text) {
+    const size_t separator = text.find('=');
+    if (separator == std::string_view::npos) return false;
+
+    const auto category = MemoryAccounting::categoryFromName(text.substr(0, separator));
+    size_t mebibytes = 0;
+    if (!category || !parseValue(text.substr(separator + 1), mebibytes)) return false;
+
+    MemoryAccounting::setBudget(*category, mebibytes * 1024 * 1024);
+    return true;
+}
+
+bool parseOptions(const int argc, char** argv, HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) return false;
+
+        const std::string_view value = argv[++i];
+        bool isValid = false;
+        if (arg == "--seed") {
+            isValid = parseValue(value, options.seed);
+        } else if (arg == "--render-distance") {
+            isValid = parseValue(value, options.renderDistance) && options.renderDistance > 0;
+        } else if (arg == "--frames") {
+            isValid = parseValue(value, options.frames) && options.frames > 0;
+        } else if (arg == "--speed") {
+            isValid = parseValue(value, options.speed) && options.speed >= 0.0f;
+        } else if (arg == "--memory-budget") {
+            isValid = parseMemoryBudget(value);
+        } else if (arg == "--trace") {
+            options.tracePath = value;
+            isValid = true;
+        } else if (arg == "--baseline") {
+            options.baselinePath = value;
+            isValid = true;
+        } else if (arg == "--write-baseline") {
+            options.writeBaselinePath = value;
+            isValid = true;
+        } else if (arg == "--tolerance") {
+            double tolerance = 0;
+            isValid = parseValue(value, tolerance) && tolerance >= 0;
+            options.toleranceOverride = tolerance;
+        } else if (arg == "--throughput-fills") {
+            isValid = parseValue(value, options.throughputFills) && options.throughputFills >= 0;
+        }
+        if (!isValid) return false;
+    }
+    return true;
+}
+
+/// Camera moving along a scripted path: straight ahead for the first 40% of the frames, then
+/// turning for the next 40%, then standing still so that the steady state is measured too
+class CameraPath {
+   public:
+    CameraPath(const Vector3& start, const int frames, const float speed)
+        : position_(start), frames_(frames), speed_(speed) {}
+
+    [[nodiscard]] TerrainViewer viewer() const {
+        const Vector3 direction = {-std::sin(yaw_), std::cos(yaw_), 0.0f};
+        return {
+            .camera =
+                {
+                    .position = position_,
+                    .target = Vector3Add(position_, direction),
+                    .up = {0.0f, 0.0f, 1.0f},
+                    .fovy = 80.0f,
+                    .projection = CAMERA_PERSPECTIVE,
+                },
+            .velocity = velocity_,
+            .yawRate = yawRate_,
+            .aspectRatio = 16.0f / 9.0f,
+        };
+    }
+
+    void step(const int frame) {
+        const bool isMoving = frame < frames_ * 4 / 5;
+        const bool isTurning = isMoving && frame >= frames_ * 2 / 5;
+
+        yawRate_ = isTurning ? TURN_RATE : 0.0f;
+        yaw_ += yawRate_ * FRAME_TIME;
+
+        isStill_ = !isMoving;
+        const float speed = isMoving ? speed_ : 0.0f;
+        velocity_ = {-std::sin(yaw_) * speed, std::cos(yaw_) * speed, 0.0f};
+        position_ = Vector3Add(position_, Vector3Scale(velocity_, FRAME_TIME));
+    }
+
+    [[nodiscard]] bool isStill() const { return isStill_; }
+
+   private:
+    Vector3 position_;
+    Vector3 velocity_{};
+    bool isStill_ = false;
+    float yaw_ = 0.0f;
+    float yawRate_ = 0.0f;
+
+    const int frames_;
+    const float speed_;
+};
+
+double secondsSince(const Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Sizes gated by the perf baselines, measured on the terrain at the end of the run
+std::vector<PerfMetric> measureSizeMetrics(const Terrain& terrain) {
+    constexpr double tolerance = 0.02;  // Sizes only change with the code
+
+    size_t triangles = 0;
+    terrain.chunks().forEach(
+        [&](const Chunk& chunk) { triangles += chunk.getMeshIndices().size() / 3; });
+    const auto chunkCount = static_cast<double>(terrain.chunks().size());
+    const size_t chunkBytes = MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA) +
+                              MemoryAccounting::bytes(MemoryCategory::CHUNK_MESHES) +
+                              MemoryAccounting::bytes(MemoryCategory::WORLD_MAP);
+    size_t peakBytes = 0;  // Sum of the peaks of the categories, a bound of the actual peak
+    for (const MemoryCategory category : MEMORY_CATEGORIES) {
+        peakBytes += MemoryAccounting::peakBytes(category);
+    }
+
+    return {
+        {"triangles_per_chunk", static_cast<double>(triangles) / chunkCount, false, tolerance},
+        {"bytes_per_chunk", static_cast<double>(chunkBytes) / chunkCount, false, tolerance},
+        {"peak_memory_mib", static_cast<double>(peakBytes) / (1024.0 * 1024.0), false, tolerance},
+    };
+}
+
+/// Throughputs for the perf baselines of a given machine: generating and meshing all the chunks
+/// around `viewer` in a fresh terrain, with a cold height cache. The best of the fills is kept, as
+/// it is the one least disturbed by the rest of the machine.
+std::vector<PerfMetric> measureThroughputMetrics(const HeadlessOptions& options,
+                                                 const TerrainViewer& viewer) {
+    constexpr double tolerance = 0.25;  // Timings vary from run to run
+
+    double generation = 0, meshing = 0;  // Chunks per second
+    for (int i = 0; i < options.throughputFills; i++) {
+        clearHeightCache();
+        Terrain terrain(options.seed, MAP_HEIGHT_BLOCKS);
+        terrain.fill(viewer, options.renderDistance);
+
+        const TerrainStats& stats = terrain.stats();
+        generation = std::max(
+            generation, static_cast<double>(stats.generatedChunks) / stats.lastGenerationSeconds);
+        meshing =
+            std::max(meshing, static_cast<double>(stats.meshedChunks) / stats.lastMeshingSeconds);
+    }
+
+    return {
+        {"generation_chunks_per_second", generation, true, tolerance},
+        {"meshing_chunks_per_second", meshing, true, tolerance},
+    };
+}
+
+/// Writes the metrics as a new baseline and compares them to the baseline file, as asked by the
+/// options. Returns false on a regression or if a file cannot be read or written.
+bool writeAndCheckBaselines(const std::vector<PerfMetric>& metrics,
+                            const HeadlessOptions& options) {
+    if (!options.writeBaselinePath.empty()) {
+        std::ofstream out(options.writeBaselinePath);
+        PerfBaseline::fromMetrics(metrics).write(out);
+        if (!out) {
+            std::cerr << "Could not write the baseline to " << options.writeBaselinePath
+                      << std::endl;
+            return false;
+        }
+    }
+    if (options.baselinePath.empty()) return true;
+
+    std::ifstream in(options.baselinePath);
+    const std::optional<PerfBaseline> baseline = PerfBaseline::parse(in);
+    if (!in.eof() || !baseline) {
+        std::cerr << "Could not read the baseline " << options.baselinePath << std::endl;
+        return false;
+    }
+
+    const std::vector<PerfComparison> comparisons =
+        baseline->compare(metrics, options.toleranceOverride);
+    std::cout << "baseline " << options.baselinePath << ":\n";
+    printPerfComparisons(std::cout, comparisons);
+    if (std::ranges::any_of(comparisons, &PerfComparison::isRegression)) {
+        std::cerr << "Performance regressed beyond the tolerance of the baseline" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// Allocations of the steady-state frames: the camera stands still and the terrain is idle, so a
+/// frame has no reason to allocate
+class SteadyStateAllocations {
+   public:
+    void add(const AllocationCounts& frame, const std::span<const ZoneAllocations> zones) {
+        frames_++;
+        if (frame.allocations == 0) return;
+
+        allocatingFrames_++;
+        for (const ZoneAllocations& zone : zones) {
+            if (zone.counts.allocations == 0) continue;
+            auto it = std::ranges::find(zones_, zone.zone, &ZoneAllocations::zone);
+            if (it == zones_.end()) it = zones_.insert(it, {zone.zone, {}});
+            it->counts.allocations += zone.counts.allocations;
+            it->counts.bytes += zone.counts.bytes;
+        }
+    }
+
+    [[nodiscard]] bool hasAllocated() const { return allocatingFrames_ > 0; }
+
+    void print(std::ostream& out) const {
+        out << std::format("steady-state frames: {}, allocating: {}\n", frames_,
+                           allocatingFrames_);
+        for (const ZoneAllocations& zone : zones_) {
+            out << std::format("  {:<12} {} allocations, {} bytes\n",
+                               zone.zone != nullptr ? zone.zone : "(no zone)",
+                               zone.counts.allocations, zone.counts.bytes);
+        }
+    }
+
+   private:
+    int frames_ = 0;
+    int allocatingFrames_ = 0;
+    std::vector<ZoneAllocations> zones_;  // Where the allocating frames allocated
+};
+
+}  // namespace
+
+int runHeadless(const int argc, char** argv) {
+    HeadlessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--seed N] [--render-distance N] [--frames N] [--speed N] [--trace PATH]"
+                  << " [--memory-budget CATEGORY=MIB]... [--baseline PATH] [--tolerance FRACTION]"
+                  << " [--write-baseline PATH] [--throughput-fills N]" << std::endl;
+        return 1;
+    }
+
+    Profiler::setThreadName("main");
+    Terrain terrain(options.seed, MAP_HEIGHT_BLOCKS);
+
+    const int groundHeight = terrain.generateSpawnColumn(0, 0);
+    CameraPath path({0.5f, 0.5f, static_cast<float>(groundHeight) + CAMERA_HEIGHT_ABOVE_GROUND},
+                    options.frames, options.speed);
+    const TerrainViewer startViewer = path.viewer();
+
+    const Clock::time_point fillStart = Clock::now();
+    terrain.fill(path.viewer(), options.renderDistance);
+    const double fillSeconds = secondsSince(fillStart);
+    const TerrainStats fillStats = terrain.stats();
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(options.frames);
+    double totalSeconds = 0.0;
+    SteadyStateAllocations steadyStateAllocations;
+    for (int frame = 0; frame < options.frames; frame++) {
+        path.step(frame);
+        const bool isSteadyState = path.isStill() && terrain.pendingGenerationCount() == 0 &&
+                                   terrain.pendingTransformsCount() == 0;
+
+        AllocationTracker::resetThreadZones();
+        const AllocationCounts allocationsBefore = AllocationTracker::threadCounts();
+        const Clock::time_point start = Clock::now();
+        {
+            PROFILE_ZONE("frame");
+            terrain.update(path.viewer(), options.renderDistance);
+        }
+        const double seconds = secondsSince(start);
+        const AllocationCounts frameAllocations =
+            AllocationTracker::threadCounts() - allocationsBefore;
+
+        frameTimes.push_back(seconds);
+        totalSeconds += seconds;
+        if (isSteadyState) {
+            steadyStateAllocations.add(frameAllocations, AllocationTracker::threadZones());
+        }
+    }
+
+    const size_t streamedChunks = terrain.stats().generatedChunks - fillStats.generatedChunks;
+    const size_t streamedMeshes = terrain.stats().meshedChunks - fillStats.meshedChunks;
+    const double maxFrameTime = std::ranges::max(frameTimes);
+    const double p50 = percentile(frameTimes, 0.50);
+    const double p99 = percentile(frameTimes, 0.99);
+
+    std::cout << std::format("seed {}, render distance {}, {} frames at {} blocks/s\n",
+                             options.seed, options.renderDistance, options.frames, options.speed);
+    std::cout << std::format("initial fill: {} chunks, {} meshes in {:.3f} s ({:.0f} chunks/s)\n",
+                             fillStats.generatedChunks, fillStats.meshedChunks, fillSeconds,
+                             static_cast<double>(fillStats.generatedChunks) / fillSeconds);
+    std::cout << std::format("streaming: {} chunks, {} meshes in {:.3f} s\n", streamedChunks,
+                             streamedMeshes, totalSeconds);
+    std::cout << std::format("throughput: {:.0f} chunks/s, {:.0f} meshes/s\n",
+                             static_cast<double>(streamedChunks) / totalSeconds,
+                             static_cast<double>(streamedMeshes) / totalSeconds);
+    std::cout << std::format(
+        "terrain time per frame: p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms\n", p50 * 1000.0,
+        p99 * 1000.0, maxFrameTime * 1000.0);
+    std::cout << std::format("holes seen: {}, prefetched chunks: {} ({} unused)\n",
+                             terrain.prefetcher().stats().holesSeen,
+                             terrain.prefetcher().stats().generated,
+                             terrain.prefetcher().stats().unused());
+    std::cout << std::format("memory budget stalls: {}\n", terrain.stats().memoryBudgetStalls);
+    MemoryAccounting::dump(std::cout);
+    if constexpr (AllocationTracker::IS_ENABLED) steadyStateAllocations.print(std::cout);
+
+    if (!options.tracePath.empty() && !Profiler::exportChromeTrace(options.tracePath)) {
+        std::cerr << "Could not write the trace to " << options.tracePath << std::endl;
+        return 1;
+    }
+    if (!options.baselinePath.empty() || !options.writeBaselinePath.empty()) {
+        std::vector<PerfMetric> metrics = measureSizeMetrics(terrain);
+        if (options.throughputFills > 0) {
+            std::ranges::move(measureThroughputMetrics(options, startViewer),
+                              std::back_inserter(metrics));
+        }
+        if (!writeAndCheckBaselines(metrics, options)) return 1;
+    }
+
+    if (steadyStateAllocations.hasAllocated()) {
+        std::cerr << "Steady-state frames allocated, see the zones above" << std::endl;
+        return 1;
+    }
+    return 0;
+}
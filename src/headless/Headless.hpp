@@ -0,0 +1,11 @@
+#pragma once
+
+/// Streams the terrain along a scripted camera path without a window, GPU upload or drawing, and
+/// prints throughput and latency numbers. Returns the process exit code.
+///
+/// Options: --seed N, --render-distance N, --frames N, --speed BLOCKS_PER_SECOND, --trace PATH,
+/// --memory-budget CATEGORY=MIB (repeatable, see `MemoryAccounting::name` for the categories),
+/// --baseline PATH to compare the perf metrics to a baseline (see `PerfBaseline`), --tolerance
+/// FRACTION to replace its tolerances, --write-baseline PATH, and --throughput-fills N to also
+/// measure throughputs over N fills of the terrain
+int runHeadless(int argc, char** argv);
@@ -0,0 +1,3 @@
+#include "Headless.hpp"
+
+int main(int argc, char** argv) { return runHeadless(argc, argv); }
@@ -1,20 +1,69 @@
+#include <iostream>
+#include <string_view>
+
 #include "game/Game.hpp"
 #include "menu/Menu.hpp"
 #include "raylib.h"
 
-int main() {
+namespace {
+
+bool parseOptions(const int argc, char** argv, GameOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--fixed-timestep") {
+            options.fixedTimestep = true;
+            continue;
+        }
+        if (arg == "--lockstep") {
+            options.lockstep = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+
+        const std::string_view value = argv[++i];
+        if (arg == "--record") {
+            options.recordPath = value;
+        } else if (arg == "--replay") {
+            options.replayPath = value;
+        } else if (arg == "--frame-log") {
+            options.frameLogPath = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(const int argc, char** argv) {
+    GameOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--record PATH | --replay PATH] [--fixed-timestep] [--lockstep]"
+                     " [--frame-log PATH]"
+                  << std::endl;
+        return 1;
+    }
+    const bool isReplaying = !options.replayPath.empty();
+
     InitWindow(720, 480, "Minecraft Clone");
     if (!IsWindowFullscreen()) ToggleFullscreen();
 
     SetTargetFPS(60);
 
-    runMenu();
+    if (!isReplaying) runMenu();
 
+    int exitCode = 0;
     if (!WindowShouldClose()) {
-        Game game;
-        game.init();
-        game.run();
+        Game game(options);
+        if (game.init()) {
+            game.run();
+        } else {
+            exitCode = 1;
+        }
     }
 
     CloseWindow();  // Close the window and OpenGL context
-}
\ No newline at end of file
+    return exitCode;
+}
@@ -0,0 +1,245 @@
+#include "Chunk.hpp"
+
+#include <bit>
+
+#include "HeightMap.hpp"
+#include "block/BlockMasks.hpp"
+#include "raymath.h"
+
+namespace {
+
+// Scratch space of `generateTransforms`, reused so that meshing only allocates when a chunk's mesh
+// outgrows what it had, instead of growing a temporary vector every time
+thread_local std::vector<Vertex> scratchVertices;
+template <typename Index>
+thread_local std::vector<Index> scratchIndices;
+
+}  // namespace
+
+template <int SizeX, int SizeY, int SizeZ>
+void BasicChunk<SizeX, SizeY, SizeZ>::generate(const int seed, const int maxHeight) {
+    for (int x = 0; x < SizeX; x++) {
+        for (int y = 0; y < SizeY; y++) {
+            const int realHeight = getHeight(localToGlobalX(x), localToGlobalY(y), seed, maxHeight);
+
+            if (localToGlobalZ(0) >= realHeight) {
+                continue;
+            }
+
+            constexpr int minGenerationHeight =
+                24;  // if the terrain is too low, fill it with water
+
+            const int lastZ =
+                std::min(std::max(realHeight, minGenerationHeight) - localToGlobalZ(0), SizeZ);
+            for (int localZ = 0; localZ < lastZ; localZ++) {
+                const int globalZToRealHeight = localToGlobalZ(localZ);
+                if (globalZToRealHeight < minGenerationHeight) {
+                    data_[x][y][localZ] = Block{BlockType::BLOCK_WATER};
+                } else if (globalZToRealHeight < minGenerationHeight + 2) {
+                    data_[x][y][localZ] = Block{BlockType::BLOCK_SAND};
+                } else if (globalZToRealHeight <= realHeight - 4) {
+                    data_[x][y][localZ] = Block{BlockType::BLOCK_STONE};
+                } else if (globalZToRealHeight <= realHeight - 2) {
+                    data_[x][y][localZ] = Block{BlockType::BLOCK_DIRT};
+                } else if (globalZToRealHeight < realHeight) {
+                    data_[x][y][localZ] = Block{BlockType::BLOCK_GRASS};
+                }
+            }
+        }
+    }
+
+    for (int x = 0; x < SizeX; x++) {
+        for (int y = 0; y < SizeY; y++) {
+            occupiedColumns_[columnIndex(x, y)] = renderedMask(data_[x][y]) != 0;
+        }
+    }
+
+    // Generated terrain is a height map: light does not need to spread sideways to reach its air
+    initializeLight();
+}
+
+template <int SizeX, int SizeY, int SizeZ>
+std::unique_ptr<BasicChunk<SizeX, SizeY, SizeZ>> BasicChunk<SizeX, SizeY, SizeZ>::copyWithoutMesh()
+    const {
+    auto copy = std::make_unique<BasicChunk>(chunkX_, chunkY_, chunkZ_);
+    copy->data_ = data_;
+    copy->light_.assign(light_);
+    copy->occupiedColumns_ = occupiedColumns_;
+    return copy;
+}
+
+template <int SizeX, int SizeY, int SizeZ>
+void BasicChunk<SizeX, SizeY, SizeZ>::initializeLight() {
+    constexpr uint8_t sky = packLight(MAX_LIGHT_LEVEL, 0);
+    constexpr uint8_t dark = packLight(0, 0);
+
+    // Height of the first rendered block from the top of each column, -1 if there is none
+    std::array<std::array<int, SizeY>, SizeX> tops;
+    bool isAllSky = true;
+    bool isAllDark = true;
+    for (int x = 0; x < SizeX; x++) {
+        for (int y = 0; y < SizeY; y++) {
+            tops[x][y] = static_cast<int>(std::bit_width(renderedMask(data_[x][y]))) - 1;
+            isAllSky &= tops[x][y] < 0;
+            isAllDark &= tops[x][y] == SizeZ - 1;
+        }
+    }
+
+    light_.fill(isAllDark ? dark : sky);
+    if (isAllSky || isAllDark) return;
+    for (int x = 0; x < SizeX; x++) {
+        for (int y = 0; y < SizeY; y++) {
+            for (int z = 0; z <= tops[x][y]; z++) light_.set(blockIndex({x, y, z}), dark);
+        }
+    }
+}
+
+template <int SizeX, int SizeY, int SizeZ>
+void BasicChunk<SizeX, SizeY, SizeZ>::generateTransforms(
+    const OptionalRef<BasicChunk> adjacentChunkPositiveX,
+    const OptionalRef<BasicChunk> adjacentChunkNegativeX,
+    const OptionalRef<BasicChunk> adjacentChunkPositiveY,
+    const OptionalRef<BasicChunk> adjacentChunkNegativeY,
+    const OptionalRef<BasicChunk> adjacentChunkPositiveZ,
+    const OptionalRef<BasicChunk> adjacentChunkNegativeZ) {
+    const size_t previousCapacityBytes = meshCapacityBytes();
+
+    meshVerts_.clear(), meshNorms_.clear(), meshUVs_.clear(), meshColors_.clear();
+    meshIndices_.clear();
+
+    // Rendered masks of the rows along Z, padded with the rows of the X and Y neighbours. Missing
+    // chunks are solid to avoid rendering faces that may turn out hidden.
+    using RowMask = BlockRowMask<SizeZ>;
+    constexpr RowMask solidRow = SizeZ == 8 * sizeof(RowMask) ? ~RowMask{0}
+                                                                : (RowMask{1} << SizeZ) - 1;
+    std::array<std::array<RowMask, SizeY + 2>, SizeX + 2> rendered;
+    for (auto& column : rendered) column.fill(solidRow);
+
+    for (int x = 0; x < SizeX; x++) {
+        for (int y = 0; y < SizeY; y++) rendered[x + 1][y + 1] = renderedMask(data_[x][y]);
+    }
+    for (int y = 0; y < SizeY; y++) {
+        if (adjacentChunkNegativeX) {
+            rendered[0][y + 1] = renderedMask(adjacentChunkNegativeX->get().data_[SizeX - 1][y]);
+        }
+        if (adjacentChunkPositiveX) {
+            rendered[SizeX + 1][y + 1] = renderedMask(adjacentChunkPositiveX->get().data_[0][y]);
+        }
+    }
+    for (int x = 0; x < SizeX; x++) {
+        if (adjacentChunkNegativeY) {
+            rendered[x + 1][0] = renderedMask(adjacentChunkNegativeY->get().data_[x][SizeY - 1]);
+        }
+        if (adjacentChunkPositiveY) {
+            rendered[x + 1][SizeY + 1] = renderedMask(adjacentChunkPositiveY->get().data_[x][0]);
+        }
+    }
+
+    // Whether the block across the Z border of the row is rendered
+    auto isRenderedAcrossZ = [](const OptionalRef<BasicChunk> chunk, const int x, const int y,
+                                const int z) -> RowMask {
+        return !chunk || chunk->get().data_[x][y][z].isRendered();
+    };
+
+    // Light of the block in front of the face of the block at (x, y, z), which lights the face.
+    // Faces are only visible towards blocks that exist.
+    const std::array<OptionalRef<BasicChunk>, 6> adjacentChunks = {
+        adjacentChunkPositiveX, adjacentChunkNegativeX, adjacentChunkPositiveY,
+        adjacentChunkNegativeY, adjacentChunkPositiveZ, adjacentChunkNegativeZ,
+    };
+    auto lightInFront = [&](const int x, const int y, const int z, const int face) {
+        constexpr std::array<Vector3Int, 6> offsets = {{
+            {1, 0, 0},
+            {-1, 0, 0},
+            {0, 1, 0},
+            {0, -1, 0},
+            {0, 0, 1},
+            {0, 0, -1},
+        }};
+        const Vector3Int front = {x + offsets[face].x, y + offsets[face].y, z + offsets[face].z};
+        if (front.x >= 0 && front.x < SizeX && front.y >= 0 && front.y < SizeY && front.z >= 0 &&
+            front.z < SizeZ) {
+            return getLight(front);
+        }
+        const Vector3Int wrapped = {(front.x + SizeX) % SizeX, (front.y + SizeY) % SizeY,
+                                    (front.z + SizeZ) % SizeZ};
+        return adjacentChunks[face]->get().getLight(wrapped);
+    };
+
+    std::vector<Vertex>& vertices = scratchVertices;
+    std::vector<MeshIndex>& indices = scratchIndices<MeshIndex>;
+    vertices.clear(), indices.clear();
+
+    for (int x = 0; x < SizeX; x++) {
+        for (int y = 0; y < SizeY; y++) {
+            const RowMask row = rendered[x + 1][y + 1];
+            if (row == 0) continue;
+
+            // Bit z of the row above/below is the block at z + 1/z - 1
+            const RowMask above = (row >> 1) |
+                                  isRenderedAcrossZ(adjacentChunkPositiveZ, x, y, 0) << (SizeZ - 1);
+            const RowMask below = (row << 1) |
+                                  isRenderedAcrossZ(adjacentChunkNegativeZ, x, y, SizeZ - 1);
+
+            // A face is visible where the block is rendered and its neighbour is not
+            const std::array<RowMask, 6> faceMasks = {
+                row & ~rendered[x + 2][y + 1],  // +X
+                row & ~rendered[x][y + 1],      // -X
+                row & ~rendered[x + 1][y + 2],  // +Y
+                row & ~rendered[x + 1][y],      // -Y
+                row & ~above,                   // +Z
+                row & ~below,                   // -Z
+            };
+
+            RowMask visible = faceMasks[0] | faceMasks[1] | faceMasks[2] | faceMasks[3] |
+                              faceMasks[4] | faceMasks[5];
+            while (visible != 0) {
+                const int z = std::countr_zero(visible);
+                visible &= visible - 1;
+
+                std::array<bool, 6> isFaceVisible{};
+                std::array<uint8_t, 6> faceLights{};
+                for (size_t face = 0; face < faceMasks.size(); face++) {
+                    isFaceVisible[face] = (faceMasks[face] >> z) & 1;
+                    if (isFaceVisible[face]) {
+                        faceLights[face] = lightInFront(x, y, z, static_cast<int>(face));
+                    }
+                }
+                data_[x][y][z].generateBlockMesh({x, y, z}, vertices, indices, isFaceVisible,
+                                                 faceLights);
+            }
+        }
+    }
+
+    meshIndices_.assign(indices.begin(), indices.end());
+    meshVerts_.reserve(vertices.size() * 3);
+    meshNorms_.reserve(vertices.size() * 3);
+    meshUVs_.reserve(vertices.size() * 2);
+    meshColors_.reserve(vertices.size() * 4);
+
+    constexpr uint8_t levelScale = 255 / MAX_LIGHT_LEVEL;  // Light levels to color channels
+    for (const auto& vertice : vertices) {
+        meshVerts_.push_back(static_cast<float>(vertice.position.x));
+        meshVerts_.push_back(static_cast<float>(vertice.position.y));
+        meshVerts_.push_back(static_cast<float>(vertice.position.z));
+
+        meshNorms_.push_back(static_cast<float>(vertice.normal.x));
+        meshNorms_.push_back(static_cast<float>(vertice.normal.y));
+        meshNorms_.push_back(static_cast<float>(vertice.normal.z));
+
+        meshUVs_.push_back(vertice.textureCoord.x);
+        meshUVs_.push_back(vertice.textureCoord.y);
+
+        meshColors_.push_back(unpackLight(vertice.light, LightChannel::SKY) * levelScale);
+        meshColors_.push_back(unpackLight(vertice.light, LightChannel::BLOCK) * levelScale);
+        meshColors_.push_back(0);
+        meshColors_.push_back(255);
+    }
+
+    MemoryAccounting::update(MemoryCategory::CHUNK_MESHES, previousCapacityBytes,
+                             meshCapacityBytes());
+}
+
+template class BasicChunk<16, 16, 16>;
+template class BasicChunk<32, 32, 32>;
+template class BasicChunk<32, 32, 64>;
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "Light.hpp"
+#include "block/Block.hpp"
+#include "block/BlockMasks.hpp"
+#include "common/MemoryAccounting.hpp"
+#include "common/UtilityTypes.hpp"
+#include "raylib.h"
+
+/// A box of `SizeX` x `SizeY` x `SizeZ` blocks, Z being up, their light and its mesh.
+///
+/// The extents are template parameters so that the storage and the mesher loops are fully
+/// specialized for each configuration. The game uses `Chunk`, the other configurations are
+/// instantiated in Chunk.cpp for the benchmarks that compare them.
+template <int SizeX, int SizeY, int SizeZ>
+class BasicChunk {
+   public:
+    static_assert(SizeX > 0 && SizeY > 0 && SizeZ > 0);
+
+    static constexpr int SIZE_X = SizeX;
+    static constexpr int SIZE_Y = SizeY;
+    static constexpr int SIZE_Z = SizeZ;
+    static constexpr int BLOCK_COUNT = SizeX * SizeY * SizeZ;
+
+    /// Index type of the mesh: 16 bits up to 32^3 blocks, which is also all raylib can upload,
+    /// and 32 bits for larger chunks, which cannot be rendered. Indices count from the first
+    /// vertex of their submesh, see `getSubmesh`.
+    using MeshIndex = std::conditional_t<BLOCK_COUNT <= 32 * 32 * 32, uint16_t, uint32_t>;
+
+    /// A run of the mesh whose indices count from its first vertex
+    struct Submesh {
+        size_t firstVertex;
+        size_t vertexCount;
+        size_t firstIndex;
+        size_t indexCount;
+    };
+
+    /// Radius of the sphere around the chunk, half its diagonal
+    static inline const float BOUNDING_RADIUS =
+        0.5f * std::sqrt(static_cast<float>(SizeX * SizeX + SizeY * SizeY + SizeZ * SizeZ));
+
+    BasicChunk(const int x, const int y, const int z) : chunkX_(x), chunkY_(y), chunkZ_(z) {
+        MemoryAccounting::add(MemoryCategory::CHUNK_DATA, sizeof(ChunkData));
+        MemoryAccounting::add(MemoryCategory::WORLD_MAP, sizeof(BasicChunk) - sizeof(ChunkData));
+    }
+
+    BasicChunk(BasicChunk&& other) noexcept = delete;
+    BasicChunk& operator=(BasicChunk&&) noexcept = delete;
+
+    BasicChunk(const BasicChunk& other) = delete;
+    BasicChunk& operator=(const BasicChunk&) = delete;
+
+    ~BasicChunk() {
+        MemoryAccounting::remove(MemoryCategory::CHUNK_DATA, sizeof(ChunkData));
+        MemoryAccounting::remove(MemoryCategory::WORLD_MAP, sizeof(BasicChunk) - sizeof(ChunkData));
+        MemoryAccounting::remove(MemoryCategory::CHUNK_MESHES, meshCapacityBytes());
+    }
+
+    [[nodiscard]] int getX() const { return chunkX_; }
+    [[nodiscard]] int getY() const { return chunkY_; }
+    [[nodiscard]] int getZ() const { return chunkZ_; }
+
+    [[nodiscard]] static Vector3 getCenterPosition(const int chunkX, const int chunkY,
+                                                   const int chunkZ) {
+        return {(static_cast<float>(chunkX) + 0.5f) * SizeX,
+                (static_cast<float>(chunkY) + 0.5f) * SizeY,
+                (static_cast<float>(chunkZ) + 0.5f) * SizeZ};
+    }
+
+    [[nodiscard]] Vector3 getCenterPosition() const {
+        return getCenterPosition(chunkX_, chunkY_, chunkZ_);
+    }
+
+    /// Position of the chunk holding the block at `position`, in world blocks
+    [[nodiscard]] static Vector3Int chunkOf(const Vector3Int& position) {
+        return {floorDiv(position.x, SizeX), floorDiv(position.y, SizeY),
+                floorDiv(position.z, SizeZ)};
+    }
+
+    /// Position of the block at `position`, in world blocks, within the chunk holding it
+    [[nodiscard]] static Vector3Int localOf(const Vector3Int& position) {
+        const Vector3Int chunk = chunkOf(position);
+        return {position.x - chunk.x * SizeX, position.y - chunk.y * SizeY,
+                position.z - chunk.z * SizeZ};
+    }
+
+    void generate(int seed, int maxHeight);
+
+    /// A copy of the blocks and the light, without the mesh. Remeshing the copy leaves the mesh of
+    /// this chunk untouched for the threads reading it.
+    [[nodiscard]] std::unique_ptr<BasicChunk> copyWithoutMesh() const;
+
+    /// Builds the mesh on the CPU, the renderer then sends it to the GPU. Missing neighbours are
+    /// treated as solid. Each face is lit by the light of the block in front of it.
+    void generateTransforms(OptionalRef<BasicChunk> adjacentChunkPositiveX,
+                            OptionalRef<BasicChunk> adjacentChunkNegativeX,
+                            OptionalRef<BasicChunk> adjacentChunkPositiveY,
+                            OptionalRef<BasicChunk> adjacentChunkNegativeY,
+                            OptionalRef<BasicChunk> adjacentChunkPositiveZ,
+                            OptionalRef<BasicChunk> adjacentChunkNegativeZ);
+
+    /// Size of the mesh built by the last `generateTransforms`
+    [[nodiscard]] size_t meshBytes() const {
+        return (meshVerts_.size() + meshNorms_.size() + meshUVs_.size()) * sizeof(float) +
+               meshColors_.size() + meshIndices_.size() * sizeof(MeshIndex);
+    }
+
+    /// Mesh built by the last `generateTransforms`, in chunk-local coordinates
+    [[nodiscard]] const std::vector<float>& getMeshVertices() const { return meshVerts_; }
+    [[nodiscard]] const std::vector<float>& getMeshNormals() const { return meshNorms_; }
+    [[nodiscard]] const std::vector<float>& getMeshTexcoords() const { return meshUVs_; }
+    /// RGBA per vertex: the sky light of the face in red and its block light in green, 0-255
+    [[nodiscard]] const std::vector<unsigned char>& getMeshColors() const { return meshColors_; }
+    [[nodiscard]] const std::vector<MeshIndex>& getMeshIndices() const { return meshIndices_; }
+
+    /// The mesh is drawn in runs of `MAX_SUBMESH_VERTICES<MeshIndex>` vertices, the last one
+    /// holding the rest, so that any pattern of blocks can be indexed with `MeshIndex`. The
+    /// surface of generated terrain fits a single one.
+    [[nodiscard]] size_t submeshCount() const {
+        constexpr size_t maxVertices = MAX_SUBMESH_VERTICES<MeshIndex>;
+        return (meshVerts_.size() / 3 + maxVertices - 1) / maxVertices;
+    }
+    [[nodiscard]] Submesh getSubmesh(const size_t submesh) const {
+        constexpr size_t maxVertices = MAX_SUBMESH_VERTICES<MeshIndex>;
+        constexpr size_t maxIndices = maxVertices / 4 * 6;  // Two triangles per quad
+        const size_t firstVertex = submesh * maxVertices;
+        const size_t firstIndex = submesh * maxIndices;
+        return {
+            .firstVertex = firstVertex,
+            .vertexCount = std::min(maxVertices, meshVerts_.size() / 3 - firstVertex),
+            .firstIndex = firstIndex,
+            .indexCount = std::min(maxIndices, meshIndices_.size() - firstIndex),
+        };
+    }
+
+    typedef std::array<std::array<std::array<Block, SizeZ>, SizeY>, SizeX> ChunkData;
+
+    [[nodiscard]] const ChunkData& getData() const { return data_; }
+
+    /// Changes the block and the occupancy of its column: its light and the mesh are left to
+    /// `LightEngine` and the mesher
+    void setBlock(const Vector3Int& local, const Block block) {
+        data_[local.x][local.y][local.z] = block;
+        occupiedColumns_[columnIndex(local.x, local.y)] =
+            block.isRendered() || renderedMask(data_[local.x][local.y]) != 0;
+    }
+
+    /// Whether the column of blocks at (x, y) holds a rendered block
+    [[nodiscard]] bool isColumnOccupied(const int x, const int y) const {
+        return occupiedColumns_[columnIndex(x, y)];
+    }
+
+    /// Whether the chunk holds no rendered block
+    [[nodiscard]] bool isEmpty() const { return occupiedColumns_.none(); }
+
+    /// Packed light of the block, see `packLight`
+    [[nodiscard]] uint8_t getLight(const Vector3Int& local) const {
+        return light_.get(blockIndex(local));
+    }
+    [[nodiscard]] uint8_t getLight(const Vector3Int& local, const LightChannel channel) const {
+        return light_.get(blockIndex(local), channel);
+    }
+    void setLight(const Vector3Int& local, const LightChannel channel, const uint8_t level) {
+        light_.set(blockIndex(local), channel, level);
+    }
+
+    /// Lights the chunk as generated terrain, whose air all sees the sky: full sky light down each
+    /// column to its first rendered block, none below, and no block light
+    void initializeLight();
+
+    /// Whether every block has the same light, which then takes no memory per block
+    [[nodiscard]] bool isLightUniform() const { return light_.isUniform(); }
+
+   private:
+    const int chunkX_;
+    const int chunkY_;
+    const int chunkZ_;
+
+    std::vector<float> meshVerts_, meshNorms_, meshUVs_;
+    std::vector<unsigned char> meshColors_;
+    std::vector<MeshIndex> meshIndices_;
+
+    ChunkData data_;  // 3D array to hold the block types in the chunk
+    LightLevels<BLOCK_COUNT> light_{packLight(MAX_LIGHT_LEVEL, 0)};  // Indexed by blockIndex
+    std::bitset<SizeX * SizeY> occupiedColumns_;                     // Indexed by columnIndex
+
+    /// Rounds towards negative infinity, unlike `/`
+    [[nodiscard]] static int floorDiv(const int value, const int divisor) {
+        return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    [[nodiscard]] static size_t blockIndex(const Vector3Int& local) {
+        return (static_cast<size_t>(local.x) * SizeY + local.y) * SizeZ + local.z;
+    }
+    [[nodiscard]] static size_t columnIndex(const int x, const int y) {
+        return static_cast<size_t>(x) * SizeY + y;
+    }
+
+    /// Memory held by the mesh vectors, which keep their capacity between two meshings
+    [[nodiscard]] size_t meshCapacityBytes() const {
+        return (meshVerts_.capacity() + meshNorms_.capacity() + meshUVs_.capacity()) *
+                   sizeof(float) +
+               meshColors_.capacity() + meshIndices_.capacity() * sizeof(MeshIndex);
+    }
+
+    [[nodiscard]] int localToGlobalX(const int x) const { return chunkX_ * SizeX + x; }
+    [[nodiscard]] int localToGlobalY(const int y) const { return chunkY_ * SizeY + y; }
+    [[nodiscard]] int localToGlobalZ(const int z) const { return chunkZ_ * SizeZ + z; }
+};
+
+/// Chunks of the game
+using Chunk = BasicChunk<32, 32, 32>;
+
+/// Configurations benchmarked against `Chunk`: more draw calls but cheaper remeshing, and fewer
+/// draw calls for columns of the same height
+using SmallChunk = BasicChunk<16, 16, 16>;
+using TallChunk = BasicChunk<32, 32, 64>;
+
+extern template class BasicChunk<16, 16, 16>;
+extern template class BasicChunk<32, 32, 32>;
+extern template class BasicChunk<32, 32, 64>;
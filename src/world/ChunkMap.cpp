@@ -0,0 +1,145 @@
+#include "ChunkMap.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "absl/hash/hash.h"
+
+namespace {
+
+void deleteChunk(void* chunk) { delete static_cast<Chunk*>(chunk); }
+
+}  // namespace
+
+ChunkMap::ChunkMap() {
+    for (Shard& shard : shards_) {
+        auto* table = new Table(MIN_TABLE_CAPACITY);
+        shard.table.store(table, std::memory_order_release);
+        tableBytes_.fetch_add(table->bytes(), std::memory_order_relaxed);
+    }
+}
+
+ChunkMap::~ChunkMap() {
+    forEach([](Chunk& chunk) { delete &chunk; });
+    for (Shard& shard : shards_) delete shard.table.load(std::memory_order_relaxed);
+    // The epoch domain frees the retired chunks and tables last
+}
+
+size_t ChunkMap::hash(const Vector3Int& position) { return absl::Hash<Vector3Int>{}(position); }
+
+Chunk* ChunkMap::find(const Vector3Int& position) const {
+    const size_t positionHash = hash(position);
+    const Table& table = *shardOf(positionHash).table.load(std::memory_order_acquire);
+    const size_t mask = table.capacity - 1;
+    for (size_t i = positionHash / SHARD_COUNT;; i++) {
+        Chunk* chunk = table.slots[i & mask].load(std::memory_order_acquire);
+        if (!chunk) return nullptr;  // Tables are never full
+        if (chunk != TOMBSTONE && isAt(*chunk, position)) return chunk;
+    }
+}
+
+std::pair<Chunk&, bool> ChunkMap::insert(std::unique_ptr<Chunk> chunk) {
+    const Vector3Int position = {chunk->getX(), chunk->getY(), chunk->getZ()};
+    const size_t positionHash = hash(position);
+    Shard& shard = shardOf(positionHash);
+    const std::scoped_lock lock(shard.writeMutex);
+
+    // Under the shard's lock, nothing the lookup reads can be retired
+    if (Chunk* existing = find(position)) return {*existing, false};
+
+    if (2 * (shard.usedSlots + 1) > shard.table.load(std::memory_order_relaxed)->capacity) {
+        rebuild(shard, std::max(MIN_TABLE_CAPACITY, std::bit_ceil(4 * (shard.chunks + 1))));
+    }
+
+    const Table& table = *shard.table.load(std::memory_order_relaxed);
+    const size_t mask = table.capacity - 1;
+    size_t i = positionHash / SHARD_COUNT;
+    while (table.slots[i & mask].load(std::memory_order_relaxed)) i++;
+
+    Chunk& inserted = *chunk;
+    table.slots[i & mask].store(chunk.release(), std::memory_order_release);
+    shard.usedSlots++;
+    shard.chunks++;
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return {inserted, true};
+}
+
+bool ChunkMap::erase(const Vector3Int& position) {
+    const size_t positionHash = hash(position);
+    Shard& shard = shardOf(positionHash);
+    {
+        const std::scoped_lock lock(shard.writeMutex);
+        const Table& table = *shard.table.load(std::memory_order_relaxed);
+        const size_t mask = table.capacity - 1;
+        for (size_t i = positionHash / SHARD_COUNT;; i++) {
+            std::atomic<Chunk*>& slot = table.slots[i & mask];
+            Chunk* chunk = slot.load(std::memory_order_relaxed);
+            if (!chunk) return false;
+            if (chunk == TOMBSTONE || !isAt(*chunk, position)) continue;
+
+            slot.store(TOMBSTONE, std::memory_order_release);
+            shard.chunks--;
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            reclamation_.retire(chunk, deleteChunk);
+            break;
+        }
+    }
+    reclamation_.collect();
+    return true;
+}
+
+bool ChunkMap::replace(std::unique_ptr<Chunk> chunk) {
+    const Vector3Int position = {chunk->getX(), chunk->getY(), chunk->getZ()};
+    const size_t positionHash = hash(position);
+    Shard& shard = shardOf(positionHash);
+    {
+        const std::scoped_lock lock(shard.writeMutex);
+        const Table& table = *shard.table.load(std::memory_order_relaxed);
+        const size_t mask = table.capacity - 1;
+        for (size_t i = positionHash / SHARD_COUNT;; i++) {
+            std::atomic<Chunk*>& slot = table.slots[i & mask];
+            Chunk* replaced = slot.load(std::memory_order_relaxed);
+            if (!replaced) return false;
+            if (replaced == TOMBSTONE || !isAt(*replaced, position)) continue;
+
+            slot.store(chunk.release(), std::memory_order_release);
+            reclamation_.retire(replaced, deleteChunk);
+            break;
+        }
+    }
+    reclamation_.collect();
+    return true;
+}
+
+void ChunkMap::reserve(const size_t count) {
+    const size_t perShard = (count + SHARD_COUNT - 1) / SHARD_COUNT;
+    // Some margin for the shards getting more than their share
+    const size_t capacity = std::bit_ceil(2 * (perShard + perShard / 4 + 1));
+    for (Shard& shard : shards_) {
+        const std::scoped_lock lock(shard.writeMutex);
+        if (shard.table.load(std::memory_order_relaxed)->capacity < capacity) {
+            rebuild(shard, capacity);
+        }
+    }
+    reclamation_.collect();
+}
+
+void ChunkMap::rebuild(Shard& shard, const size_t capacity) {
+    Table* previous = shard.table.load(std::memory_order_relaxed);
+    auto* table = new Table(capacity);
+    const size_t mask = capacity - 1;
+    for (size_t i = 0; i < previous->capacity; i++) {
+        Chunk* chunk = previous->slots[i].load(std::memory_order_relaxed);
+        if (!chunk || chunk == TOMBSTONE) continue;
+
+        size_t j = hash({chunk->getX(), chunk->getY(), chunk->getZ()}) / SHARD_COUNT;
+        while (table->slots[j & mask].load(std::memory_order_relaxed)) j++;
+        table->slots[j & mask].store(chunk, std::memory_order_relaxed);
+    }
+
+    shard.table.store(table, std::memory_order_release);
+    shard.usedSlots = shard.chunks;
+    tableBytes_.fetch_add(table->bytes(), std::memory_order_relaxed);
+    tableBytes_.fetch_sub(previous->bytes(), std::memory_order_relaxed);
+    reclamation_.retire(previous, [](void* retired) { delete static_cast<Table*>(retired); });
+}
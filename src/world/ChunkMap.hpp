@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Chunk.hpp"
+#include "common/EpochReclamation.hpp"
+#include "common/UtilityStructures.hpp"
+
+/// The chunks of the world by position, readable from any thread while they are inserted,
+/// replaced and erased.
+///
+/// Positions are spread over shards, each an open addressing table of chunk pointers, the chunk
+/// holding its own position. Lookups take no lock: they probe the shard's current table, whose
+/// slots are only ever filled, swapped for a chunk at the same position or turned into tombstones.
+/// Writes lock their shard; a shard growing publishes a new table.
+///
+/// Erased or replaced chunks and replaced tables are retired to an epoch domain and freed once no
+/// reader can see them. A lookup from another thread therefore pins a `ReadGuard`, and the chunks
+/// it found stay alive, even if erased meanwhile, until the guard is destroyed. The thread that
+/// erases and replaces chunks cannot race with itself and may look chunks up without a guard.
+class ChunkMap {
+   public:
+    using ReadGuard = EpochDomain::Guard;
+
+    constexpr static size_t SHARD_COUNT = 64;
+
+    ChunkMap();
+    ChunkMap(const ChunkMap&) = delete;
+    ChunkMap& operator=(const ChunkMap&) = delete;
+
+    /// Destroys every chunk: no guard may outlive the map
+    ~ChunkMap();
+
+    [[nodiscard]] ReadGuard pin() const { return reclamation_.pin(); }
+
+    /// From any thread: the chunk lives as long as `guard`
+    [[nodiscard]] Chunk* find(const Vector3Int& position, const ReadGuard& guard) const {
+        (void)guard;
+        return find(position);
+    }
+
+    /// From the thread that erases and replaces chunks only
+    [[nodiscard]] Chunk* find(const Vector3Int& position) const;
+    [[nodiscard]] bool contains(const Vector3Int& position) const {
+        return find(position) != nullptr;
+    }
+
+    /// Adds the chunk unless its position is taken, from any thread. Returns the chunk at the
+    /// position and whether it is the one given.
+    std::pair<Chunk&, bool> insert(std::unique_ptr<Chunk> chunk);
+
+    /// Puts the chunk in the place of the one at its position, from any thread. The replaced chunk
+    /// is freed once no guard can see it anymore. Returns false, dropping the chunk, if there was
+    /// none.
+    bool replace(std::unique_ptr<Chunk> chunk);
+
+    /// Removes the chunk at the position, which is freed once no guard can see it anymore. Returns
+    /// whether there was one.
+    bool erase(const Vector3Int& position);
+
+    /// Frees the chunks and tables retired that no guard can see anymore
+    void collectRetired() { reclamation_.collect(); }
+
+    /// Makes room for `count` chunks in total, spread evenly, so that inserting them does not grow
+    /// the tables
+    void reserve(size_t count);
+
+    /// Calls `function(Chunk&)` on every chunk, from the thread erasing and replacing them only
+    template <typename Function>
+    void forEach(Function&& function) const {
+        for (const Shard& shard : shards_) {
+            const Table& table = *shard.table.load(std::memory_order_acquire);
+            for (size_t i = 0; i < table.capacity; i++) {
+                Chunk* chunk = table.slots[i].load(std::memory_order_acquire);
+                if (chunk && chunk != TOMBSTONE) function(*chunk);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return size_.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /// Memory held by the current tables
+    [[nodiscard]] size_t memoryBytes() const {
+        return sizeof(ChunkMap) + tableBytes_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    constexpr static size_t MIN_TABLE_CAPACITY = 16;
+
+    struct Table {
+        explicit Table(const size_t slotCount)
+            : capacity(slotCount), slots(std::make_unique<std::atomic<Chunk*>[]>(slotCount)) {}
+
+        const size_t capacity;  // A power of two, at least twice the slots used
+        const std::unique_ptr<std::atomic<Chunk*>[]> slots;
+
+        [[nodiscard]] size_t bytes() const {
+            return sizeof(Table) + capacity * sizeof(std::atomic<Chunk*>);
+        }
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<Table*> table;
+        std::mutex writeMutex;
+        size_t usedSlots = 0;  // Chunks and tombstones of the table, under writeMutex
+        size_t chunks = 0;     // Under writeMutex
+    };
+
+    // Marks the slot of an erased chunk, which lookups probe past
+    inline static char tombstone_ = 0;
+    inline static Chunk* const TOMBSTONE = reinterpret_cast<Chunk*>(&tombstone_);
+
+    mutable EpochDomain reclamation_;
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> tableBytes_{0};
+
+    [[nodiscard]] static size_t hash(const Vector3Int& position);
+    [[nodiscard]] const Shard& shardOf(size_t hash) const { return shards_[hash % SHARD_COUNT]; }
+    [[nodiscard]] Shard& shardOf(const size_t hash) { return shards_[hash % SHARD_COUNT]; }
+
+    [[nodiscard]] static bool isAt(const Chunk& chunk, const Vector3Int& position) {
+        return chunk.getX() == position.x && chunk.getY() == position.y &&
+               chunk.getZ() == position.z;
+    }
+
+    /// Replaces the table of the shard by one of `capacity` slots holding its chunks, under the
+    /// shard's lock
+    void rebuild(Shard& shard, size_t capacity);
+};
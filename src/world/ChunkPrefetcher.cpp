@@ -0,0 +1,26 @@
+#include "ChunkPrefetcher.hpp"
+
+#include <cmath>
+
+#include "raymath.h"
+
+Vector3 ChunkPrefetcher::predictPosition(const Vector3& position, const Vector3& velocity,
+                                         const float yawRate, const float seconds) {
+    // Moving at constant speed while turning at a constant rate follows an arc. Its chord is the
+    // straight displacement rotated by half the total turn, and shortened by sin(t/2) / (t/2) for
+    // a turn t: the arc is as long as the straight displacement.
+    const float halfTurn = yawRate * seconds * 0.5f;
+    const float chordRatio = std::abs(halfTurn) < 1e-4f ? 1.0f : std::sin(halfTurn) / halfTurn;
+    const Vector2 displacement =
+        Vector2Rotate(Vector2Scale({velocity.x, velocity.y}, seconds * chordRatio), halfTurn);
+    return {position.x + displacement.x, position.y + displacement.y,
+            position.z + velocity.z * seconds};
+}
+
+void ChunkPrefetcher::onPrefetchedChunkGenerated(const Vector3Int& position) {
+    if (unusedPrefetchedChunks_.insert(position).second) stats_.generated++;
+}
+
+void ChunkPrefetcher::onChunkEnteredRenderDistance(const Vector3Int& position) {
+    if (unusedPrefetchedChunks_.erase(position) > 0) stats_.used++;
+}
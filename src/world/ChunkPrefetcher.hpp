@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "Chunk.hpp"
+#include "Frustum.hpp"
+#include "absl/container/flat_hash_set.h"
+#include "common/UtilityStructures.hpp"
+#include "raylib.h"
+
+struct ChunkPrefetchStats {
+    size_t requested = 0;  // Generation requests issued ahead of the player
+    size_t generated = 0;  // Chunks generated while outside the render distance
+    size_t used = 0;       // Prefetched chunks that later entered the render distance
+    size_t holesSeen = 0;  // Missing chunks in view and in range, summed over all samples
+    size_t lastHoles = 0;  // Missing chunks in view and in range at the last sample
+
+    /// Prefetched chunks that never entered the render distance (yet), i.e. potentially wasted work
+    [[nodiscard]] size_t unused() const { return generated - used; }
+};
+
+/// Requests the generation of chunks around where the player will be in a few moments, so that
+/// fast movement does not outrun generation.
+///
+/// The player's position is extrapolated `lookahead` seconds ahead along its velocity, turned by
+/// its current yaw rate. Whenever the predicted chunk changes, every missing chunk around it that
+/// is not already covered by the regular render distance is requested.
+class ChunkPrefetcher {
+   public:
+    constexpr static float DEFAULT_LOOKAHEAD_SECONDS = 1.5f;
+    constexpr static float MIN_SPEED = 10.0f;  // Below this speed, generation keeps up on its own
+
+    explicit ChunkPrefetcher(const float lookahead = DEFAULT_LOOKAHEAD_SECONDS)
+        : lookahead_(lookahead) {}
+
+    void setLookahead(const float seconds) { lookahead_ = std::max(seconds, 0.0f); }
+    [[nodiscard]] float lookahead() const { return lookahead_; }
+
+    [[nodiscard]] const ChunkPrefetchStats& stats() const { return stats_; }
+
+    /// Position of the player `seconds` from now, assuming its speed and yaw rate stay constant
+    [[nodiscard]] static Vector3 predictPosition(const Vector3& position, const Vector3& velocity,
+                                                 float yawRate, float seconds);
+
+    /// Requests the chunks around the predicted position, if it moved to another chunk since the
+    /// last call or if `force` is set (e.g. because the pending requests were dropped).
+    ///
+    /// `offsets` are the column offsets of the render distance, `isLoaded(position)` tells whether
+    /// a chunk exists and `request(position)` queues its generation
+    template <typename IsLoaded, typename Request>
+    void update(const Vector3& predictedPosition, const Vector2Int& playerChunk,
+                const std::vector<Vector2Int>& offsets, const int renderDistance,
+                const int columnHeightChunks, const bool force, IsLoaded&& isLoaded,
+                Request&& request) {
+        const Vector2Int predictedChunk = {
+            static_cast<int>(std::floor(predictedPosition.x / Chunk::SIZE_X)),
+            static_cast<int>(std::floor(predictedPosition.y / Chunk::SIZE_Y))};
+
+        if (predictedChunk == playerChunk) {
+            lastPredictedChunk_ = std::nullopt;
+            return;
+        }
+        if (!force && predictedChunk == lastPredictedChunk_) return;
+        lastPredictedChunk_ = predictedChunk;
+
+        for (const Vector2Int& offset : offsets) {
+            const Vector2Int column = predictedChunk + offset;
+            const int dx = column.x - playerChunk.x;
+            const int dy = column.y - playerChunk.y;
+            if (dx * dx + dy * dy < renderDistance * renderDistance) continue;  // Already queued
+
+            for (int z = 0; z < columnHeightChunks; z++) {
+                const Vector3Int position = {column.x, column.y, z};
+                if (isLoaded(position)) continue;
+                request(position);
+                stats_.requested++;
+            }
+        }
+    }
+
+    /// To be called when a chunk is generated outside the render distance
+    void onPrefetchedChunkGenerated(const Vector3Int& position);
+
+    /// To be called when a loaded chunk enters the render distance
+    void onChunkEnteredRenderDistance(const Vector3Int& position);
+
+    /// Counts the chunks within the render distance and in view for which `isHole(position)`
+    /// returns true, i.e. the terrain the player can see missing
+    template <typename IsHole>
+    void sampleHoles(const Vector2Int& playerChunk, const std::vector<Vector2Int>& offsets,
+                     const int columnHeightChunks, const Frustum& frustum, IsHole&& isHole) {
+        size_t holes = 0;
+        for (const Vector2Int& offset : offsets) {
+            const Vector2Int column = playerChunk + offset;
+            for (int z = 0; z < columnHeightChunks; z++) {
+                const Vector3Int position = {column.x, column.y, z};
+                const Vector3 center = Chunk::getCenterPosition(column.x, column.y, z);
+                if (frustum.containsSphere(center, Chunk::BOUNDING_RADIUS) && isHole(position)) {
+                    holes++;
+                }
+            }
+        }
+
+        stats_.lastHoles = holes;
+        stats_.holesSeen += holes;
+    }
+
+   private:
+    float lookahead_;
+
+    std::optional<Vector2Int> lastPredictedChunk_;
+
+    absl::flat_hash_set<Vector3Int> unusedPrefetchedChunks_;
+
+    ChunkPrefetchStats stats_{};
+};
@@ -0,0 +1,77 @@
+#include "ChunkPriorityQueue.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Chunk.hpp"
+#include "raymath.h"
+
+float ChunkPriorityQueue::priority(const Vector3Int& position,
+                                   const ChunkPriorityContext& context) {
+    const Vector3 center = Chunk::getCenterPosition(position.x, position.y, position.z);
+    const Vector3 toChunk = Vector3Subtract(center, context.playerPosition);
+    const float distance = Vector3Length(toChunk);
+
+    float priority = distance;
+    if (!context.frustum.containsSphere(center, Chunk::BOUNDING_RADIUS)) {
+        priority *= OUT_OF_VIEW_PENALTY;
+    }
+
+    const float speed = Vector3Length(context.playerVelocity);
+    if (speed > 0.0f && distance > 0.0f) {
+        const float alignment =
+            Vector3DotProduct(toChunk, context.playerVelocity) / (distance * speed);
+        const float speedFactor = std::min(speed / VELOCITY_REFERENCE_SPEED, 1.0f);
+        priority *= 1.0f - VELOCITY_BONUS * std::max(alignment, 0.0f) * speedFactor;
+    }
+
+    return priority;
+}
+
+bool ChunkPriorityQueue::isInRange(const Vector3Int& position,
+                                   const ChunkPriorityContext& context) {
+    const Vector3 center = Chunk::getCenterPosition(position.x, position.y, position.z);
+    auto isInRangeOf = [&](const Vector3& origin) {
+        const float dx = center.x - origin.x;
+        const float dy = center.y - origin.y;
+        return dx * dx + dy * dy < context.maxDistance * context.maxDistance;
+    };
+    return isInRangeOf(context.playerPosition) || isInRangeOf(context.predictedPosition);
+}
+
+void ChunkPriorityQueue::push(const Vector3Int& position, const ChunkPriorityContext& context) {
+    if (!queued_.insert(position).second) return;
+
+    heap_.push_back({priority(position, context), position});
+    std::ranges::push_heap(heap_, std::ranges::greater{}, &Request::priority);
+}
+
+std::optional<Vector3Int> ChunkPriorityQueue::pop() {
+    if (heap_.empty()) return std::nullopt;
+
+    std::ranges::pop_heap(heap_, std::ranges::greater{}, &Request::priority);
+    const Vector3Int position = heap_.back().position;
+    heap_.pop_back();
+    queued_.erase(position);
+    return position;
+}
+
+void ChunkPriorityQueue::reprioritize(const ChunkPriorityContext& context) {
+    const auto cancelled = std::ranges::remove_if(heap_, [&](const Request& request) {
+        if (isInRange(request.position, context)) return false;
+        queued_.erase(request.position);
+        return true;
+    });
+    cancelledCount_ += cancelled.size();
+    heap_.erase(cancelled.begin(), cancelled.end());
+
+    for (Request& request : heap_) {
+        request.priority = priority(request.position, context);
+    }
+    std::ranges::make_heap(heap_, std::ranges::greater{}, &Request::priority);
+}
+
+void ChunkPriorityQueue::clear() {
+    heap_.clear();
+    queued_.clear();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Frustum.hpp"
+#include "absl/container/flat_hash_set.h"
+#include "common/UtilityStructures.hpp"
+#include "raylib.h"
+
+/// Everything chunk requests are prioritized against
+struct ChunkPriorityContext {
+    Vector3 playerPosition{};
+    Vector3 playerVelocity{};  // In blocks per second
+    Vector3 predictedPosition{};  // Where the player is expected to be soon, see ChunkPrefetcher
+    Frustum frustum{};
+    float maxDistance = 0.0f;  // Horizontal distance from both positions beyond which requests are
+                               // cancelled
+};
+
+/// Queue of chunk requests (generation or meshing) popped most urgent first.
+///
+/// Urgency grows as chunks get closer, are inside the view frustum or lie in the direction the
+/// player is moving. Priorities are computed when a request is pushed and only recomputed by
+/// `reprioritize`, which the caller triggers when the camera turns or the player's velocity
+/// changes.
+class ChunkPriorityQueue {
+   public:
+    /// Queues a request, does nothing if the chunk is already queued
+    void push(const Vector3Int& position, const ChunkPriorityContext& context);
+
+    /// Pops the most urgent request, if any
+    [[nodiscard]] std::optional<Vector3Int> pop();
+
+    /// Recomputes the priority of every queued request and cancels those out of range
+    void reprioritize(const ChunkPriorityContext& context);
+
+    void clear();
+
+    [[nodiscard]] bool empty() const { return heap_.empty(); }
+    [[nodiscard]] size_t size() const { return heap_.size(); }
+    [[nodiscard]] bool contains(const Vector3Int& position) const {
+        return queued_.contains(position);
+    }
+
+    /// Number of requests cancelled by `reprioritize` since the queue was created
+    [[nodiscard]] size_t cancelledCount() const { return cancelledCount_; }
+
+    /// Lower is more urgent
+    [[nodiscard]] static float priority(const Vector3Int& position,
+                                        const ChunkPriorityContext& context);
+
+    [[nodiscard]] static bool isInRange(const Vector3Int& position,
+                                        const ChunkPriorityContext& context);
+
+   private:
+    constexpr static float OUT_OF_VIEW_PENALTY = 4.0f;
+    constexpr static float VELOCITY_BONUS = 0.5f;  // Max relative gain for chunks ahead
+    constexpr static float VELOCITY_REFERENCE_SPEED = 17.5f;  // Speed at which the bonus is maxed
+
+    struct Request {
+        float priority;
+        Vector3Int position;
+    };
+
+    std::vector<Request> heap_;  // Min-heap on priority
+    absl::flat_hash_set<Vector3Int> queued_;
+
+    size_t cancelledCount_ = 0;
+};
@@ -0,0 +1,45 @@
+#include "ChunkTaskGraph.hpp"
+
+#include <utility>
+
+void ChunkTaskGraph::completeGeneration(const Vector3Int& position) {
+    Node& node = nodes_[position];
+    if (node.isGenerated) return;
+    node.isGenerated = true;
+
+    // The mesh jobs of the chunk and of its neighbours no longer wait for it
+    forEachDependency(position, [&](const Vector3Int& dependent) {
+        const auto it = nodes_.find(dependent);
+        if (it == nodes_.end()) return;
+        Node& dependentNode = it->second;
+        if (!dependentNode.isMeshRequested || dependentNode.waitingDependencies == 0) return;
+        if (--dependentNode.waitingDependencies == 0) {
+            waitingMeshes_--;
+            listRunnable(dependent, dependentNode);
+        }
+    });
+}
+
+void ChunkTaskGraph::completeMesh(const Vector3Int& position) {
+    Node& node = nodes_[position];
+    if (node.isMeshRequested && node.waitingDependencies > 0) waitingMeshes_--;
+    node.isMeshRequested = false;
+    node.isMeshed = true;
+}
+
+void ChunkTaskGraph::cancelUnrequestedMeshes() {
+    for (auto& [_, node] : nodes_) {
+        if (!node.isMeshRequested || node.requestRound == round_) continue;
+        if (node.waitingDependencies > 0) waitingMeshes_--;
+        node.isMeshRequested = false;
+    }
+}
+
+std::vector<Vector3Int> ChunkTaskGraph::takeRunnableMeshes() {
+    std::vector<Vector3Int> runnable;
+    runnable.swap(runnableMeshes_);
+    for (const Vector3Int& position : runnable) {
+        nodes_.find(position)->second.isListedRunnable = false;
+    }
+    return runnable;
+}
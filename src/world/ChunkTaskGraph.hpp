@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "common/UtilityStructures.hpp"
+
+/// Readiness of the jobs of the chunk pipeline: a chunk's mesh job waits for the generation jobs
+/// of the chunk and of its six neighbours.
+///
+/// The graph does not run jobs. It counts, for each requested mesh job, the generation jobs it
+/// still waits for; the caller reports each generation it ran, and the mesh jobs with nothing left
+/// to wait for are listed as runnable, once each until the caller takes the list. A chunk is
+/// therefore meshed once, when its neighbourhood is complete, instead of once per neighbour
+/// arriving. Neighbours above or below the world's column of chunks never exist and are not waited
+/// for. Running the jobs, when and in which order, is left to the caller: `Terrain` runs them
+/// itself in `update`. Uploads are not tracked either: the renderer uploads the chunks listed by
+/// `Terrain::meshedChunks`.
+class ChunkTaskGraph {
+   public:
+    explicit ChunkTaskGraph(const int columnHeightChunks)
+        : columnHeightChunks_(columnHeightChunks) {}
+
+    /// Adds the mesh job of the chunk unless it ran already, and calls
+    /// `scheduleGeneration(position)` for each generation job it waits for. Requesting a waiting
+    /// job again schedules its generation jobs again, and a runnable one already taken is listed
+    /// again, so that requests dropped by the caller's queues can be reissued.
+    template <typename ScheduleGeneration>
+    void requestMesh(const Vector3Int& position, ScheduleGeneration&& scheduleGeneration) {
+        Node& node = nodes_[position];
+        if (node.isMeshed) return;
+
+        if (!node.isMeshRequested) {
+            node.isMeshRequested = true;
+            node.waitingDependencies = 0;
+            forEachDependency(position, [&](const Vector3Int& dependency) {
+                const auto it = nodes_.find(dependency);
+                if (it == nodes_.end() || !it->second.isGenerated) node.waitingDependencies++;
+            });
+            if (node.waitingDependencies > 0) waitingMeshes_++;
+        }
+        node.requestRound = round_;
+
+        if (node.waitingDependencies == 0) {
+            listRunnable(position, node);
+            return;
+        }
+        forEachDependency(position, [&](const Vector3Int& dependency) {
+            const auto it = nodes_.find(dependency);
+            if (it == nodes_.end() || !it->second.isGenerated) scheduleGeneration(dependency);
+        });
+    }
+
+    /// Marks the chunk generated, making the mesh jobs it was the last dependency of runnable
+    void completeGeneration(const Vector3Int& position);
+
+    /// Marks the chunk meshed: its mesh job will not be requested again
+    void completeMesh(const Vector3Int& position);
+
+    /// Starts a round of requests, see `cancelUnrequestedMeshes`
+    void beginRound() { round_++; }
+
+    /// Cancels the mesh jobs not requested since the last `beginRound`, e.g. after the caller
+    /// reissued the requests of every chunk it still wants
+    void cancelUnrequestedMeshes();
+
+    /// Mesh jobs that became runnable since the last call, each once, to be run by the caller
+    [[nodiscard]] std::vector<Vector3Int> takeRunnableMeshes();
+
+    [[nodiscard]] bool isGenerated(const Vector3Int& position) const {
+        const auto it = nodes_.find(position);
+        return it != nodes_.end() && it->second.isGenerated;
+    }
+    [[nodiscard]] bool isMeshed(const Vector3Int& position) const {
+        const auto it = nodes_.find(position);
+        return it != nodes_.end() && it->second.isMeshed;
+    }
+
+    /// Mesh jobs requested that still wait for generation jobs
+    [[nodiscard]] size_t waitingMeshCount() const { return waitingMeshes_; }
+
+    /// Memory held by the graph's nodes, slots included
+    [[nodiscard]] size_t memoryBytes() const {
+        return nodes_.capacity() * (sizeof(decltype(nodes_)::value_type) + 1) +
+               runnableMeshes_.capacity() * sizeof(Vector3Int);
+    }
+
+   private:
+    struct Node {
+        bool isGenerated = false;
+        bool isMeshRequested = false;  // Until the mesh job completes or is cancelled
+        bool isMeshed = false;
+        bool isListedRunnable = false;    // In `runnableMeshes_`
+        uint8_t waitingDependencies = 0;  // Generation jobs the mesh job waits for
+        uint32_t requestRound = 0;
+    };
+
+    constexpr static std::array<Vector3Int, 7> DEPENDENCY_OFFSETS = {{
+        {0, 0, 0},
+        {1, 0, 0},
+        {-1, 0, 0},
+        {0, 1, 0},
+        {0, -1, 0},
+        {0, 0, 1},
+        {0, 0, -1},
+    }};
+
+    const int columnHeightChunks_;
+
+    absl::flat_hash_map<Vector3Int, Node> nodes_;
+    std::vector<Vector3Int> runnableMeshes_;
+    size_t waitingMeshes_ = 0;
+    uint32_t round_ = 0;
+
+    void listRunnable(const Vector3Int& position, Node& node) {
+        if (node.isListedRunnable) return;
+        node.isListedRunnable = true;
+        runnableMeshes_.push_back(position);
+    }
+
+    /// The generation jobs the mesh job of the chunk depends on, which are also the mesh jobs the
+    /// generation job of the chunk is a dependency of
+    template <typename Function>
+    void forEachDependency(const Vector3Int& position, Function&& function) const {
+        for (const Vector3Int& offset : DEPENDENCY_OFFSETS) {
+            const Vector3Int dependency = position + offset;
+            if (dependency.z >= 0 && dependency.z < columnHeightChunks_) function(dependency);
+        }
+    }
+};
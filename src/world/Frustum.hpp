@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "raylib.h"
+#include "raymath.h"
+
+/// View frustum of a perspective camera, without the far plane (the render distance already
+/// bounds what is drawn)
+class Frustum {
+   public:
+    Frustum() = default;
+
+    [[nodiscard]] static Frustum fromCamera(const Camera& camera, const float aspectRatio) {
+        const Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        const Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+        const Vector3 up = Vector3CrossProduct(right, forward);
+
+        const float halfFovV = camera.fovy * DEG2RAD * 0.5f;
+        const float halfFovH = std::atan(std::tan(halfFovV) * aspectRatio);
+
+        auto inwardNormal = [&](const float halfFov, const Vector3& axis, const float sign) {
+            return Vector3Add(Vector3Scale(forward, std::sin(halfFov)),
+                              Vector3Scale(axis, sign * std::cos(halfFov)));
+        };
+
+        Frustum frustum;
+        frustum.origin_ = camera.position;
+        frustum.normals_ = {
+            forward,                            // Near
+            inwardNormal(halfFovH, right, 1),   // Left
+            inwardNormal(halfFovH, right, -1),  // Right
+            inwardNormal(halfFovV, up, 1),      // Bottom
+            inwardNormal(halfFovV, up, -1),     // Top
+        };
+        return frustum;
+    }
+
+    /// Whether a sphere is at least partially inside the frustum
+    [[nodiscard]] bool containsSphere(const Vector3& center, const float radius) const {
+        const Vector3 relativeCenter = Vector3Subtract(center, origin_);
+        for (const Vector3& normal : normals_) {
+            if (Vector3DotProduct(normal, relativeCenter) < -radius) return false;
+        }
+        return true;
+    }
+
+   private:
+    Vector3 origin_{};
+    std::array<Vector3, 5> normals_{};  // Inward plane normals, all planes go through origin_
+};
@@ -0,0 +1,113 @@
+#include "HeightMap.hpp"
+
+#include <cmath>
+#include <utility>
+
+#include "PerlinNoise.hpp"
+#include "absl/container/flat_hash_map.h"
+#include "common/MemoryAccounting.hpp"
+
+float fBm(const float x, const float y, const int octaves, const float lacunarity, const float gain,
+          const int seed) {
+    float amplitude = 1.0f;
+    float frequency = 1.0f;
+    float sum = 0.0f;
+    for (int i = 0; i < octaves; i++) {
+        sum += amplitude * stb_perlin_noise2_seed(x * frequency, y * frequency, seed + i);
+        amplitude *= gain;
+        frequency *= lacunarity;
+    }
+    return sum;
+}
+
+float computeMaxAmplitude(const int octaves, const float gain) {
+    float a = 1.0f;
+    float maxAmp = 0.0f;
+    for (int i = 0; i < octaves; i++) {
+        maxAmp += a;
+        a *= gain;
+    }
+    return maxAmp;
+}
+
+namespace {
+
+// Heights depend on the seed and the world height too, several terrains can share the cache
+struct Key {
+    int x, y;
+    int seed, maxWorldHeight;
+
+    bool operator==(const Key& other) const noexcept = default;
+
+    // absl::Hash mixes the fields: open addressing needs well distributed low and high bits
+    template <typename H>
+    friend H AbslHashValue(H hash, const Key& key) {
+        return H::combine(std::move(hash), key.x, key.y, key.seed, key.maxWorldHeight);
+    }
+};
+
+// Open addressing: inserting a height allocates only when the table grows, not once per entry
+absl::flat_hash_map<Key, int> heightCache;
+size_t accountedHeightCacheBytes = 0;  // Last size reported to MemoryAccounting
+
+void accountHeightCache() {
+    const size_t bytes = heightCacheBytes();
+    MemoryAccounting::update(MemoryCategory::HEIGHT_CACHE, accountedHeightCacheBytes, bytes);
+    accountedHeightCacheBytes = bytes;
+}
+
+}  // namespace
+
+int getHeight(const int x, const int y, const int seed, const int maxWorldHeight) {
+    const Key key{x, y, seed, maxWorldHeight};
+    if (const auto it = heightCache.find(key); it != heightCache.end()) {
+        return it->second;
+    }
+
+    constexpr int octaves = 6;
+    constexpr float lacunarity = 2.0f;
+    constexpr float gain = 0.5f;
+    constexpr float noiseScale = 0.005f;  // tweak as needed
+
+    // raw fBM in [ -maxAmp, +maxAmp ]
+    const float raw = fBm(static_cast<float>(x) * noiseScale, static_cast<float>(y) * noiseScale,
+                          octaves, lacunarity, gain, seed);
+
+    // normalize to [-1,1]
+    const float maxAmp = computeMaxAmplitude(octaves, gain);
+    const float n = raw / maxAmp;
+
+    // normalize to [0,1]
+    const float normalized = (n + 1.0f) * 0.5f;
+
+    //   Option A: linear map to [0, maxWorldHeight]
+    // const float height = normalized * maxWorldHeight;
+
+    //   Option B: exponential for spikier relief
+    const float height = std::pow(normalized, 4.0f) * static_cast<float>(maxWorldHeight);
+
+    //   Option C: mix linear + exponent
+    // const float heightLinear = normalized * 80.0f;                          // [0, 80]
+    // const float heightExponentiated = std::pow(normalized, 3.0f) * 120.0f;  // [0, 120]
+    // const float height =
+    //     heightLinear * (1 - normalized) + heightExponentiated * normalized + 4;  // [4, 124]
+
+    heightCache[key] = static_cast<int>(std::ceil(height));
+    accountHeightCache();
+
+    // Heights are cheap to compute again, so the cache simply starts over when too big
+    if (MemoryAccounting::isOverBudget(MemoryCategory::HEIGHT_CACHE)) clearHeightCache();
+
+    return static_cast<int>(std::ceil(height));
+}
+
+void clearHeightCache() {
+    // Swapped rather than cleared, so that its slots are released too
+    decltype(heightCache)().swap(heightCache);
+    accountHeightCache();
+}
+
+size_t heightCacheBytes() {
+    // A slot per entry of the capacity, plus one control byte
+    return heightCache.capacity() * (sizeof(decltype(heightCache)::value_type) + 1);
+}
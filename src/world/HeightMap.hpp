@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+/// Fractal Brownian motion: `octaves` layers of Perlin noise, each `lacunarity` times finer and
+/// `gain` times weaker than the previous one
+float fBm(float x, float y, int octaves, float lacunarity, float gain, int seed);
+
+/// Highest value `fBm` can reach with these parameters
+float computeMaxAmplitude(int octaves, float gain);
+
+/// Terrain height at the block column (x, y), in blocks. Heights are cached once computed, the
+/// cache is cleared when it goes over its memory budget.
+int getHeight(int x, int y, int seed, int maxWorldHeight);
+
+/// Forgets every cached height, e.g. to measure `getHeight` cold
+void clearHeightCache();
+
+/// Approximate memory used by the cached heights, slots included
+size_t heightCacheBytes();
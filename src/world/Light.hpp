@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "common/MemoryAccounting.hpp"
+
+/// Light levels go from 0 (dark) to MAX_LIGHT_LEVEL (open sky). They drop by one per block
+/// travelled, except sky light going straight down, which stays at MAX_LIGHT_LEVEL.
+constexpr uint8_t MAX_LIGHT_LEVEL = 15;
+
+enum class LightChannel : uint8_t {
+    SKY,
+    BLOCK,  // Emitted by blocks, see `BlockTypeData::lightEmission`
+};
+
+/// Sky light in the high nibble, block light in the low one
+[[nodiscard]] constexpr uint8_t packLight(const uint8_t sky, const uint8_t block) {
+    return static_cast<uint8_t>(sky << 4 | block);
+}
+[[nodiscard]] constexpr uint8_t unpackLight(const uint8_t packed, const LightChannel channel) {
+    return channel == LightChannel::SKY ? packed >> 4 : packed & 0x0f;
+}
+
+/// The packed light of the blocks of a chunk.
+///
+/// Most chunks are uniformly lit, all sky above the ground or all dark below it, and hold a single
+/// value; the levels of every block are only allocated once they differ.
+template <size_t BlockCount>
+class LightLevels {
+   public:
+    explicit LightLevels(const uint8_t uniform) : uniform_(uniform) {}
+
+    LightLevels(const LightLevels&) = delete;
+    LightLevels& operator=(const LightLevels&) = delete;
+
+    ~LightLevels() { fill(0); }
+
+    [[nodiscard]] uint8_t get(const size_t index) const {
+        return levels_ ? (*levels_)[index] : uniform_;
+    }
+
+    [[nodiscard]] uint8_t get(const size_t index, const LightChannel channel) const {
+        return unpackLight(get(index), channel);
+    }
+
+    void set(const size_t index, const uint8_t packed) {
+        if (!levels_) {
+            if (packed == uniform_) return;
+            levels_ = std::make_unique<Levels>();
+            levels_->fill(uniform_);
+            MemoryAccounting::add(MemoryCategory::CHUNK_DATA, sizeof(Levels));
+        }
+        (*levels_)[index] = packed;
+    }
+
+    void set(const size_t index, const LightChannel channel, const uint8_t level) {
+        const uint8_t packed = get(index);
+        set(index, channel == LightChannel::SKY ? packLight(level, packed & 0x0f)
+                                                : packLight(packed >> 4, level));
+    }
+
+    /// Sets every block to `packed`, releasing the per-block levels
+    void fill(const uint8_t packed) {
+        if (levels_) MemoryAccounting::remove(MemoryCategory::CHUNK_DATA, sizeof(Levels));
+        levels_.reset();
+        uniform_ = packed;
+    }
+
+    /// Copies the levels of `other`, which may not be uniform
+    void assign(const LightLevels& other) {
+        if (!other.levels_) {
+            fill(other.uniform_);
+            return;
+        }
+        if (!levels_) {
+            levels_ = std::make_unique<Levels>();
+            MemoryAccounting::add(MemoryCategory::CHUNK_DATA, sizeof(Levels));
+        }
+        *levels_ = *other.levels_;
+    }
+
+    [[nodiscard]] bool isUniform() const { return levels_ == nullptr; }
+
+   private:
+    using Levels = std::array<uint8_t, BlockCount>;
+
+    std::unique_ptr<Levels> levels_;
+    uint8_t uniform_;  // Of every block while levels_ is null
+};
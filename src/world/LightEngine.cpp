@@ -0,0 +1,224 @@
+#include "LightEngine.hpp"
+
+#include "common/Profiler.hpp"
+
+namespace {
+
+constexpr LightChannel CHANNELS[] = {LightChannel::SKY, LightChannel::BLOCK};
+
+int& component(Vector3Int& vector, const size_t axis) {
+    return axis == 0 ? vector.x : axis == 1 ? vector.y : vector.z;
+}
+
+}  // namespace
+
+LightEngine::LightEngine(ChunkMap& chunks, const int mapHeightBlocks)
+    : chunks_(chunks), mapHeightBlocks_(mapHeightBlocks) {}
+
+std::optional<LightEngine::BlockRef> LightEngine::locate(const Vector3Int& position) {
+    const Vector3Int chunkPosition = Chunk::chunkOf(position);
+    if (!cachedChunk_ || !(chunkPosition == cachedChunkPosition_)) {
+        cachedChunk_ = chunks_.find(chunkPosition);
+        cachedChunkPosition_ = chunkPosition;
+        if (!cachedChunk_) return std::nullopt;
+    }
+    return BlockRef{*cachedChunk_, Chunk::localOf(position)};
+}
+
+void LightEngine::setLevel(const BlockRef& block, const LightChannel channel,
+                           const uint8_t level) {
+    block.chunk.setLight(block.local, channel, level);
+
+    const Vector3Int chunk = {block.chunk.getX(), block.chunk.getY(), block.chunk.getZ()};
+    if (!hasChangedChunk_ || !(chunk == lastChangedChunk_)) {
+        changedChunks_.insert(chunk);
+        litChunks_.insert(chunk);
+        lastChangedChunk_ = chunk;
+        hasChangedChunk_ = true;
+    }
+
+    // The faces of the neighbour against this block are lit by it
+    const std::array<int, 3> sizes = {Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z};
+    Vector3Int local = block.local;
+    for (size_t axis = 0; axis < 3; axis++) {
+        const int coordinate = component(local, axis);
+        if (coordinate == 0) changedChunks_.insert(chunk + NEIGHBOUR_OFFSETS[2 * axis + 1]);
+        if (coordinate == sizes[axis] - 1) {
+            changedChunks_.insert(chunk + NEIGHBOUR_OFFSETS[2 * axis]);
+        }
+    }
+}
+
+uint8_t LightEngine::spreadLevel(const LightChannel channel, const size_t direction,
+                                 const uint8_t level) {
+    if (channel == LightChannel::SKY && direction == DOWN && level == MAX_LIGHT_LEVEL) {
+        return MAX_LIGHT_LEVEL;
+    }
+    return level > 0 ? level - 1 : 0;
+}
+
+void LightEngine::blockChanged(const Vector3Int& position, const Block previous) {
+    cachedChunk_ = nullptr;
+    const std::optional<BlockRef> block = locate(position);
+    if (!block || block->block().type() == previous.type()) return;
+    for (const LightChannel channel : CHANNELS) blockChanged(position, *block, channel);
+}
+
+void LightEngine::blockChanged(const Vector3Int& position, const BlockRef& block,
+                               const LightChannel channel) {
+    Queues& channelQueues = queues(channel);
+
+    // Whatever the block let through or emitted is gone
+    if (const uint8_t level = block.chunk.getLight(block.local, channel); level > 0) {
+        setLevel(block, channel, 0);
+        channelQueues.removals.push_back({position, level});
+    }
+
+    const uint8_t emission = channel == LightChannel::BLOCK ? block.block().lightEmission() : 0;
+    if (emission > 0) {
+        setLevel(block, channel, emission);
+        channelQueues.additions.push_back(position);
+    }
+
+    // A block light passes through is lit again by its neighbours, or by the sky at the top
+    if (!block.block().isRendered()) {
+        if (channel == LightChannel::SKY && position.z == mapHeightBlocks_ - 1) {
+            setLevel(block, channel, MAX_LIGHT_LEVEL);
+            channelQueues.additions.push_back(position);
+        }
+        for (const Vector3Int& offset : NEIGHBOUR_OFFSETS) {
+            channelQueues.additions.push_back(position + offset);
+        }
+    }
+}
+
+void LightEngine::chunkGenerated(const Vector3Int& position) {
+    cachedChunk_ = nullptr;
+    if (litChunks_.empty()) return;
+    for (size_t direction = 0; direction < NEIGHBOUR_OFFSETS.size(); direction++) {
+        const Vector3Int neighbour = position + NEIGHBOUR_OFFSETS[direction];
+        if (litChunks_.contains(neighbour) && chunks_.contains(neighbour)) {
+            exchangeBorderLight(position, direction);
+        }
+    }
+}
+
+void LightEngine::exchangeBorderLight(const Vector3Int& position, const size_t direction) {
+    const std::array<int, 3> sizes = {Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z};
+    const size_t axis = direction / 2;
+    const size_t axisU = (axis + 1) % 3;
+    const size_t axisV = (axis + 2) % 3;
+    const bool isPositive = direction % 2 == 0;
+
+    const Vector3Int origin = {position.x * Chunk::SIZE_X, position.y * Chunk::SIZE_Y,
+                               position.z * Chunk::SIZE_Z};
+    for (int u = 0; u < sizes[axisU]; u++) {
+        for (int v = 0; v < sizes[axisV]; v++) {
+            // The block of the new chunk against the border, and the neighbour's across it
+            Vector3Int inside = origin;
+            component(inside, axis) += isPositive ? sizes[axis] - 1 : 0;
+            component(inside, axisU) += u;
+            component(inside, axisV) += v;
+            const Vector3Int across = inside + NEIGHBOUR_OFFSETS[direction];
+
+            const std::optional<BlockRef> insideBlock = locate(inside);
+            const std::optional<BlockRef> acrossBlock = locate(across);
+            for (const LightChannel channel : CHANNELS) {
+                Queues& channelQueues = queues(channel);
+                const uint8_t insideLevel =
+                    insideBlock->chunk.getLight(insideBlock->local, channel);
+                const uint8_t acrossLevel =
+                    acrossBlock->chunk.getLight(acrossBlock->local, channel);
+
+                // Generated as if open to the sky, the new chunk is shadowed by what is built above
+                if (channel == LightChannel::SKY && direction == UP &&
+                    insideLevel == MAX_LIGHT_LEVEL && acrossLevel != MAX_LIGHT_LEVEL) {
+                    setLevel(*insideBlock, channel, 0);
+                    channelQueues.removals.push_back({inside, insideLevel});
+                    continue;
+                }
+                if (insideLevel > 1) channelQueues.additions.push_back(inside);
+                if (acrossLevel > 1) channelQueues.additions.push_back(across);
+            }
+        }
+    }
+}
+
+void LightEngine::propagate() {
+    PROFILE_ZONE("light");
+    cachedChunk_ = nullptr;
+    hasChangedChunk_ = false;
+    for (const LightChannel channel : CHANNELS) {
+        propagateRemovals(channel);
+        propagateAdditions(channel);
+    }
+}
+
+void LightEngine::propagateRemovals(const LightChannel channel) {
+    Queues& channelQueues = queues(channel);
+    std::vector<Removal>& removals = channelQueues.removals;
+    for (size_t i = 0; i < removals.size(); i++) {
+        const Removal removal = removals[i];
+        for (size_t direction = 0; direction < NEIGHBOUR_OFFSETS.size(); direction++) {
+            const Vector3Int position = removal.position + NEIGHBOUR_OFFSETS[direction];
+            const std::optional<BlockRef> neighbour = locate(position);
+            if (!neighbour) continue;
+            const uint8_t level = neighbour->chunk.getLight(neighbour->local, channel);
+            if (level == 0) continue;
+
+            // Light at least as strong as the removed light comes from elsewhere, and spreads
+            // back into the hole. Sky light straight down is as strong as what it came from.
+            const bool isFromRemoved =
+                level < removal.level || (channel == LightChannel::SKY && direction == DOWN &&
+                                          level == MAX_LIGHT_LEVEL && removal.level == level);
+            if (!isFromRemoved) {
+                channelQueues.additions.push_back(position);
+                continue;
+            }
+
+            setLevel(*neighbour, channel, 0);
+            removals.push_back({position, level});
+            const uint8_t emission =
+                channel == LightChannel::BLOCK ? neighbour->block().lightEmission() : 0;
+            if (emission > 0) {
+                setLevel(*neighbour, channel, emission);
+                channelQueues.additions.push_back(position);
+            }
+        }
+    }
+    removals.clear();
+}
+
+void LightEngine::propagateAdditions(const LightChannel channel) {
+    std::vector<Vector3Int>& additions = queues(channel).additions;
+    for (size_t i = 0; i < additions.size(); i++) {
+        const Vector3Int position = additions[i];
+        const std::optional<BlockRef> block = locate(position);
+        if (!block) continue;
+        const uint8_t level = block->chunk.getLight(block->local, channel);
+        if (level <= 1) continue;
+
+        for (size_t direction = 0; direction < NEIGHBOUR_OFFSETS.size(); direction++) {
+            const Vector3Int neighbourPosition = position + NEIGHBOUR_OFFSETS[direction];
+            const std::optional<BlockRef> neighbour = locate(neighbourPosition);
+            if (!neighbour || neighbour->block().isRendered()) continue;
+
+            const uint8_t spread = spreadLevel(channel, direction, level);
+            if (neighbour->chunk.getLight(neighbour->local, channel) < spread) {
+                setLevel(*neighbour, channel, spread);
+                additions.push_back(neighbourPosition);
+            }
+        }
+    }
+    additions.clear();
+}
+
+size_t LightEngine::memoryBytes() const {
+    size_t bytes = sizeof(LightEngine);
+    for (const Queues& channelQueues : queues_) {
+        bytes += channelQueues.removals.capacity() * sizeof(Removal) +
+                 channelQueues.additions.capacity() * sizeof(Vector3Int);
+    }
+    // Slots and control bytes of the sets
+    return bytes + (changedChunks_.capacity() + litChunks_.capacity()) * (sizeof(Vector3Int) + 1);
+}
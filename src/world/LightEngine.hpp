@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "Chunk.hpp"
+#include "ChunkMap.hpp"
+#include "Light.hpp"
+#include "absl/container/flat_hash_set.h"
+#include "common/UtilityStructures.hpp"
+
+/// Spreads sky and block light through the world as blocks change, across chunk borders.
+///
+/// Updates are incremental: a changed block only removes the light that came through it, with a
+/// breadth-first flood fill, then the light around the hole spreads back into it with another. A
+/// batch of changes is queued first and propagated at once.
+///
+/// Generated chunks come lit (see `Chunk::initializeLight`), so the engine only works where blocks
+/// changed, and lets that light in and out of the chunks generated next to them later. It lists
+/// the chunks whose mesh the light changed: the chunk and the neighbours whose border faces it
+/// lights. Runs on the terrain's thread.
+class LightEngine {
+   public:
+    LightEngine(ChunkMap& chunks, int mapHeightBlocks);
+
+    /// Queues the update of the light around a block just changed from `previous`, at `position`
+    /// in world blocks
+    void blockChanged(const Vector3Int& position, Block previous);
+
+    /// Queues the exchange of light between the chunk just generated at `position`, in chunks, and
+    /// its neighbours lit by the engine
+    void chunkGenerated(const Vector3Int& position);
+
+    /// Runs the queued updates
+    void propagate();
+
+    /// Chunks whose mesh is outdated by the light changes since the last `clearChangedChunks`
+    [[nodiscard]] const absl::flat_hash_set<Vector3Int>& changedChunks() const {
+        return changedChunks_;
+    }
+    void clearChangedChunks() {
+        changedChunks_.clear();
+        hasChangedChunk_ = false;
+    }
+
+    [[nodiscard]] size_t memoryBytes() const;
+
+   private:
+    constexpr static size_t CHANNEL_COUNT = 2;
+
+    // Neighbours in the order of the mesher's faces: +X, -X, +Y, -Y, +Z, -Z
+    constexpr static std::array<Vector3Int, 6> NEIGHBOUR_OFFSETS = {{
+        {1, 0, 0},
+        {-1, 0, 0},
+        {0, 1, 0},
+        {0, -1, 0},
+        {0, 0, 1},
+        {0, 0, -1},
+    }};
+    constexpr static size_t UP = 4;
+    constexpr static size_t DOWN = 5;
+
+    struct BlockRef {
+        Chunk& chunk;
+        Vector3Int local;
+
+        [[nodiscard]] const Block& block() const {
+            return chunk.getData()[local.x][local.y][local.z];
+        }
+    };
+
+    /// Light that was removed from a block, to remove from the blocks it lit in turn
+    struct Removal {
+        Vector3Int position;
+        uint8_t level;
+    };
+
+    /// Flood fill queues of a channel, in world blocks. Both are consumed in order, and cleared
+    /// but not freed once empty.
+    struct Queues {
+        std::vector<Removal> removals;
+        std::vector<Vector3Int> additions;  // Blocks whose light spreads to their neighbours
+    };
+
+    ChunkMap& chunks_;
+    const int mapHeightBlocks_;
+
+    std::array<Queues, CHANNEL_COUNT> queues_;
+
+    absl::flat_hash_set<Vector3Int> changedChunks_;
+    absl::flat_hash_set<Vector3Int> litChunks_;  // Whose light the engine ever changed
+
+    // Chunk of the last lookup, which the next one most likely hits again
+    Vector3Int cachedChunkPosition_{};
+    Chunk* cachedChunk_ = nullptr;
+    Vector3Int lastChangedChunk_{};  // Skips inserting the same chunks again and again
+    bool hasChangedChunk_ = false;
+
+    /// The block at `position` if its chunk is generated
+    [[nodiscard]] std::optional<BlockRef> locate(const Vector3Int& position);
+
+    [[nodiscard]] Queues& queues(const LightChannel channel) {
+        return queues_[static_cast<size_t>(channel)];
+    }
+
+    void setLevel(const BlockRef& block, LightChannel channel, uint8_t level);
+
+    /// Level reaching a block from a neighbour at `level`, in direction `direction`
+    [[nodiscard]] static uint8_t spreadLevel(LightChannel channel, size_t direction,
+                                             uint8_t level);
+
+    void blockChanged(const Vector3Int& position, const BlockRef& block, LightChannel channel);
+
+    /// Lets the light through the border between the chunk at `position` and its neighbour at
+    /// NEIGHBOUR_OFFSETS[direction]
+    void exchangeBorderLight(const Vector3Int& position, size_t direction);
+
+    void propagateRemovals(LightChannel channel);
+    void propagateAdditions(LightChannel channel);
+};
@@ -0,0 +1,140 @@
+#include "Raycast.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace {
+
+constexpr float NEVER = std::numeric_limits<float>::infinity();
+constexpr std::array<int, 3> CHUNK_SIZES = {Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z};
+
+/// The ray, per axis
+struct Ray {
+    std::array<float, 3> origin;
+    std::array<float, 3> direction;  // Normalized
+    std::array<float, 3> inverse;    // 1 / direction
+    std::array<int, 3> step;         // -1, 0 or 1
+
+    /// Distance along the ray at which it leaves `block` (a coordinate along `axis`) through the
+    /// face across `axis`. Computed from the block rather than accumulated, so that it does not
+    /// depend on how the walk got there.
+    [[nodiscard]] float exitDistance(const size_t axis, const int block) const {
+        if (step[axis] == 0) return NEVER;
+        const int face = step[axis] > 0 ? block + 1 : block;
+        return (static_cast<float>(face) - origin[axis]) * inverse[axis];
+    }
+};
+
+/// Whether the ray crosses a face across `axis` at `distance` before one across `otherAxis` at
+/// `otherDistance`: on a tie, through an edge or a corner, it steps along the lowest axis first
+bool isBefore(const float distance, const size_t axis, const float otherDistance,
+              const size_t otherAxis) {
+    return distance < otherDistance || (distance == otherDistance && axis < otherAxis);
+}
+
+}  // namespace
+
+std::optional<RaycastHit> raycast(const ChunkMap& chunks, const Vector3& origin,
+                                  const Vector3& direction, const float maxDistance) {
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y +
+                                   direction.z * direction.z);
+    if (!(length > 0)) return std::nullopt;
+
+    Ray ray{};
+    std::array<int, 3> block{};
+    const std::array<float, 3> origins = {origin.x, origin.y, origin.z};
+    const std::array<float, 3> directions = {direction.x, direction.y, direction.z};
+    for (size_t axis = 0; axis < 3; axis++) {
+        ray.origin[axis] = origins[axis];
+        ray.direction[axis] = directions[axis] / length;
+        ray.inverse[axis] = 1.0f / ray.direction[axis];
+        ray.step[axis] = ray.direction[axis] > 0 ? 1 : ray.direction[axis] < 0 ? -1 : 0;
+        block[axis] = static_cast<int>(std::floor(origins[axis]));
+    }
+
+    float distance = 0;  // Where the ray entered `block`
+    Vector3Int normal = {0, 0, 0};
+
+    const Chunk* chunk = nullptr;
+    bool isChunkEmpty = true;
+    bool isChunkFound = false;
+    std::array<int, 3> chunkPosition{};  // Of the chunk looked up last
+    std::array<int, 3> chunkOrigin{};    // Its first block
+
+    while (distance <= maxDistance) {
+        const Vector3Int found = Chunk::chunkOf({block[0], block[1], block[2]});
+        const std::array<int, 3> position = {found.x, found.y, found.z};
+        if (!isChunkFound || position != chunkPosition) {
+            chunkPosition = position;
+            for (size_t axis = 0; axis < 3; axis++) {
+                chunkOrigin[axis] = position[axis] * CHUNK_SIZES[axis];
+            }
+            chunk = chunks.find({position[0], position[1], position[2]});
+            isChunkEmpty = !chunk || chunk->isEmpty();
+            isChunkFound = true;
+        }
+
+        // The box of blocks the ray crosses in one step: the chunk without a block, the column
+        // without a block or else the block itself
+        std::array<int, 3> low = block;
+        std::array<int, 3> high = block;
+        if (isChunkEmpty) {
+            for (size_t axis = 0; axis < 3; axis++) {
+                low[axis] = chunkOrigin[axis];
+                high[axis] = chunkOrigin[axis] + CHUNK_SIZES[axis] - 1;
+            }
+        } else {
+            const int x = block[0] - chunkOrigin[0];
+            const int y = block[1] - chunkOrigin[1];
+            if (!chunk->isColumnOccupied(x, y)) {
+                low[2] = chunkOrigin[2];
+                high[2] = chunkOrigin[2] + Chunk::SIZE_Z - 1;
+            } else if (chunk->getData()[x][y][block[2] - chunkOrigin[2]].isRendered()) {
+                return RaycastHit{{block[0], block[1], block[2]}, normal, distance};
+            }
+        }
+
+        // The ray leaves the box through the first face it crosses at its far side
+        size_t exitAxis = 0;
+        float exit = NEVER;
+        for (size_t axis = 0; axis < 3; axis++) {
+            const int last = ray.step[axis] > 0 ? high[axis] : low[axis];
+            const float axisExit = ray.exitDistance(axis, last);
+            if (isBefore(axisExit, axis, exit, exitAxis)) {
+                exit = axisExit;
+                exitAxis = axis;
+            }
+        }
+
+        // Meanwhile, it moves along the other axes by as many blocks as it crosses faces across
+        // them, which is estimated then corrected for rounding
+        for (size_t axis = 0; axis < 3; axis++) {
+            const int step = ray.step[axis];
+            const int maxMoves = ((step > 0 ? high[axis] : low[axis]) - block[axis]) * step;
+            if (axis == exitAxis || maxMoves == 0) continue;
+            auto isCrossedFirst = [&](const int moves) {
+                return isBefore(ray.exitDistance(axis, block[axis] + moves * step), axis, exit,
+                                exitAxis);
+            };
+            int moves = 0;
+            if (isCrossedFirst(0)) {
+                const float estimate =
+                    (exit - ray.exitDistance(axis, block[axis])) * std::abs(ray.direction[axis]);
+                moves = 1 + static_cast<int>(std::min(static_cast<float>(maxMoves - 1), estimate));
+            }
+            while (moves > 0 && !isCrossedFirst(moves - 1)) moves--;
+            while (moves < maxMoves && isCrossedFirst(moves)) moves++;
+            block[axis] += moves * step;
+        }
+
+        block[exitAxis] = (ray.step[exitAxis] > 0 ? high[exitAxis] : low[exitAxis]) +
+                          ray.step[exitAxis];
+        distance = exit;
+        normal = {0, 0, 0};
+        (exitAxis == 0 ? normal.x : exitAxis == 1 ? normal.y : normal.z) = -ray.step[exitAxis];
+    }
+    return std::nullopt;
+}
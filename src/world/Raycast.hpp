@@ -0,0 +1,23 @@
+#pragma once
+
+#include <optional>
+
+#include "ChunkMap.hpp"
+#include "common/UtilityStructures.hpp"
+#include "raylib.h"
+
+/// The first rendered block along a ray
+struct RaycastHit {
+    Vector3Int block;
+    Vector3Int normal;  // Of the face the ray entered through, zero if it started in the block
+    float distance;     // From the origin to where the ray entered the block
+};
+
+/// Walks the blocks along the ray from `origin` in `direction`, of any length, with the DDA of
+/// Amanatides and Woo, and returns the first rendered one the ray enters within `maxDistance`.
+/// Missing and empty chunks and the empty columns of a chunk are crossed in one step.
+///
+/// Looks chunks up without a guard: call it from the thread that replaces them, or while holding
+/// a `ChunkMap::ReadGuard`.
+[[nodiscard]] std::optional<RaycastHit> raycast(const ChunkMap& chunks, const Vector3& origin,
+                                                const Vector3& direction, float maxDistance);
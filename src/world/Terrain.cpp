@@ -0,0 +1,396 @@
+#include "Terrain.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "common/Profiler.hpp"
+#include "raymath.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Neighbours in the order of the mesher's faces: +X, -X, +Y, -Y, +Z, -Z
+constexpr std::array<Vector3Int, 6> NEIGHBOUR_OFFSETS = {{
+    {1, 0, 0},
+    {-1, 0, 0},
+    {0, 1, 0},
+    {0, -1, 0},
+    {0, 0, 1},
+    {0, 0, -1},
+}};
+
+double secondsSince(const Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Whether generating more chunks would grow a category that is over its budget
+bool isChunkMemoryOverBudget() {
+    return MemoryAccounting::isOverBudget(MemoryCategory::CHUNK_DATA) ||
+           MemoryAccounting::isOverBudget(MemoryCategory::CHUNK_MESHES) ||
+           MemoryAccounting::isOverBudget(MemoryCategory::WORLD_MAP);
+}
+
+}  // namespace
+
+int Terrain::generateSpawnColumn(const int x, const int y) {
+    const Vector2Int column = chunkColumn({static_cast<float>(x), static_cast<float>(y), 0.0f});
+    for (int z = 0; z < mapHeightBlocks_ / Chunk::SIZE_Z; z++) {
+        if (!world_.contains({column.x, column.y, z})) generateChunk({column.x, column.y, z});
+    }
+
+    const int localX = x - column.x * Chunk::SIZE_X;
+    const int localY = y - column.y * Chunk::SIZE_Y;
+    int height = 0;
+    while (height < mapHeightBlocks_ &&
+           world_.find({column.x, column.y, height / Chunk::SIZE_Z})
+                   ->getData()[localX][localY][height % Chunk::SIZE_Z]
+                   .type() != BlockType::BLOCK_AIR) {
+        height++;
+    }
+    return height;
+}
+
+bool Terrain::isPositionInRenderDistance(const Vector3& position) const {
+    const float maxDistanceSq = renderDistance_ * renderDistance_ * Chunk::SIZE_X * Chunk::SIZE_X;
+    return (position.x - viewerPosition_.x) * (position.x - viewerPosition_.x) +
+               (position.y - viewerPosition_.y) * (position.y - viewerPosition_.y) <
+           maxDistanceSq;
+}
+
+std::array<OptionalRef<Chunk>, 6> Terrain::findAdjacentChunks(const Chunk& chunk) const {
+    std::array<OptionalRef<Chunk>, 6> adjacentChunks{};
+    const int x = chunk.getX();
+    const int y = chunk.getY();
+    const int z = chunk.getZ();
+
+    auto addAdjacentChunk = [&](const int dx, const int dy, const int dz, const size_t index) {
+        Chunk* adjacentChunk = world_.find({x + dx, y + dy, z + dz});
+        adjacentChunks[index] = adjacentChunk ? OptionalRef<Chunk>{*adjacentChunk} : std::nullopt;
+    };
+    addAdjacentChunk(+1, 0, 0, 0);  // Positive X
+    addAdjacentChunk(-1, 0, 0, 1);  // Negative X
+    addAdjacentChunk(0, +1, 0, 2);  // Positive Y
+    addAdjacentChunk(0, -1, 0, 3);  // Negative Y
+    addAdjacentChunk(0, 0, +1, 4);  // Positive Z
+    addAdjacentChunk(0, 0, -1, 5);  // Negative Z
+
+    return adjacentChunks;
+}
+
+Chunk& Terrain::generateChunk(const Vector3Int& pos) {
+    PROFILE_ZONE("generate");
+    auto [chunk, _] = world_.insert(std::make_unique<Chunk>(pos.x, pos.y, pos.z));
+    chunk.generate(seed_, mapHeightBlocks_);
+    stats_.generatedChunks++;
+    lightEngine_.chunkGenerated(pos);
+    lightEngine_.propagate();
+    taskGraph_.completeGeneration(pos);
+    accountWorldMap();
+    return chunk;
+}
+
+void Terrain::accountWorldMap() {
+    const size_t bytes =
+        world_.memoryBytes() + lightEngine_.memoryBytes() + taskGraph_.memoryBytes();
+    MemoryAccounting::update(MemoryCategory::WORLD_MAP, accountedWorldMapBytes_, bytes);
+    accountedWorldMapBytes_ = bytes;
+}
+
+size_t Terrain::setBlock(const Vector3Int& position, const Block block) {
+    return fillBox(position, position, block);
+}
+
+size_t Terrain::fillBox(const Vector3Int& min, const Vector3Int& max, const Block block) {
+    return editBlocks(min, max, block, [](const Vector3Int&) { return true; });
+}
+
+size_t Terrain::fillSphere(const Vector3& center, const float radius, const Block block) {
+    auto floorToInt = [](const float value) { return static_cast<int>(std::floor(value)); };
+    const Vector3Int min = {floorToInt(center.x - radius), floorToInt(center.y - radius),
+                            floorToInt(center.z - radius)};
+    const Vector3Int max = {floorToInt(center.x + radius), floorToInt(center.y + radius),
+                            floorToInt(center.z + radius)};
+    return editBlocks(min, max, block, [&](const Vector3Int& position) {
+        const Vector3 blockCenter = {static_cast<float>(position.x) + 0.5f,
+                                     static_cast<float>(position.y) + 0.5f,
+                                     static_cast<float>(position.z) + 0.5f};
+        return Vector3DistanceSqr(blockCenter, center) <= radius * radius;
+    });
+}
+
+std::optional<Block> Terrain::findBlock(const Vector3Int& position) const {
+    const Chunk* chunk = world_.find(Chunk::chunkOf(position));
+    if (!chunk) return std::nullopt;
+    const Vector3Int local = Chunk::localOf(position);
+    return chunk->getData()[local.x][local.y][local.z];
+}
+
+template <typename Contains>
+size_t Terrain::editBlocks(const Vector3Int& min, const Vector3Int& max, const Block block,
+                           Contains&& contains) {
+    size_t changedBlocks = 0;
+    const Vector3Int minChunk = Chunk::chunkOf(min);
+    const Vector3Int maxChunk = Chunk::chunkOf(max);
+    for (int chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++) {
+        for (int chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++) {
+            for (int chunkZ = minChunk.z; chunkZ <= maxChunk.z; chunkZ++) {
+                const Vector3Int chunkPosition = {chunkX, chunkY, chunkZ};
+                Chunk* chunk = world_.find(chunkPosition);
+                if (!chunk) continue;
+
+                // The part of the box within the chunk, in chunk-local coordinates
+                const Vector3Int origin = {chunkX * Chunk::SIZE_X, chunkY * Chunk::SIZE_Y,
+                                           chunkZ * Chunk::SIZE_Z};
+                const Vector3Int from = {std::max(min.x - origin.x, 0),
+                                         std::max(min.y - origin.y, 0),
+                                         std::max(min.z - origin.z, 0)};
+                const Vector3Int to = {std::min(max.x - origin.x, Chunk::SIZE_X - 1),
+                                       std::min(max.y - origin.y, Chunk::SIZE_Y - 1),
+                                       std::min(max.z - origin.z, Chunk::SIZE_Z - 1)};
+
+                // Faces of the chunk that changed blocks lie against, in the order of
+                // NEIGHBOUR_OFFSETS: the neighbours across them show or hide their faces
+                std::array<bool, 6> isFaceEdited{};
+                size_t chunkChangedBlocks = 0;
+                for (int x = from.x; x <= to.x; x++) {
+                    for (int y = from.y; y <= to.y; y++) {
+                        for (int z = from.z; z <= to.z; z++) {
+                            const Block previous = chunk->getData()[x][y][z];
+                            const Vector3Int position = origin + Vector3Int{x, y, z};
+                            if (previous.type() == block.type() || !contains(position)) continue;
+
+                            chunk->setBlock({x, y, z}, block);
+                            lightEngine_.blockChanged(position, previous);
+                            chunkChangedBlocks++;
+                            isFaceEdited[0] |= x == Chunk::SIZE_X - 1;
+                            isFaceEdited[1] |= x == 0;
+                            isFaceEdited[2] |= y == Chunk::SIZE_Y - 1;
+                            isFaceEdited[3] |= y == 0;
+                            isFaceEdited[4] |= z == Chunk::SIZE_Z - 1;
+                            isFaceEdited[5] |= z == 0;
+                        }
+                    }
+                }
+                if (chunkChangedBlocks == 0) continue;
+
+                changedBlocks += chunkChangedBlocks;
+                editedChunks_.insert(chunkPosition);
+                for (size_t face = 0; face < NEIGHBOUR_OFFSETS.size(); face++) {
+                    if (isFaceEdited[face]) {
+                        editedChunks_.insert(chunkPosition + NEIGHBOUR_OFFSETS[face]);
+                    }
+                }
+            }
+        }
+    }
+    return changedBlocks;
+}
+
+void Terrain::remeshEditedChunks() {
+    // Light is only left to spread after edits: generating a chunk propagates its light at once
+    if (editedChunks_.empty() && lightEngine_.changedChunks().empty()) return;
+    const Clock::time_point start = Clock::now();
+
+    lightEngine_.propagate();
+    editedChunks_.insert(lightEngine_.changedChunks().begin(), lightEngine_.changedChunks().end());
+    lightEngine_.clearChangedChunks();
+
+    for (const Vector3Int& position : editedChunks_) {
+        // The chunks not meshed yet will be, edits included
+        if (!taskGraph_.isMeshed(position)) continue;
+        const Chunk* chunk = world_.find(position);
+        if (!chunk) continue;
+
+        // The current mesh may be uploading on another thread
+        std::unique_ptr<Chunk> remeshed = chunk->copyWithoutMesh();
+        generateChunkTransforms(*remeshed);
+        world_.replace(std::move(remeshed));
+        meshedChunks_.push_back(position);
+        stats_.remeshedChunks++;
+    }
+    editedChunks_.clear();
+    stats_.lastMeshingSeconds += secondsSince(start);
+}
+
+void Terrain::generateChunkTransforms(Chunk& chunk) const {
+    PROFILE_ZONE("mesh");
+    const auto adjacentChunks = findAdjacentChunks(chunk);
+    chunk.generateTransforms(adjacentChunks[0],   // Positive X
+                             adjacentChunks[1],   // Negative X
+                             adjacentChunks[2],   // Positive Y
+                             adjacentChunks[3],   // Negative Y
+                             adjacentChunks[4],   // Positive Z
+                             adjacentChunks[5]);  // Negative Z
+}
+
+Vector2Int Terrain::chunkColumn(const Vector3& position) {
+    return {static_cast<int>(std::floor(position.x / Chunk::SIZE_X)),
+            static_cast<int>(std::floor(position.y / Chunk::SIZE_Y))};
+}
+
+Vector3 Terrain::predictedViewerPosition(const TerrainViewer& viewer) const {
+    if (Vector3Length(viewer.velocity) < ChunkPrefetcher::MIN_SPEED) {
+        return viewer.camera.position;
+    }
+    return ChunkPrefetcher::predictPosition(viewer.camera.position, viewer.velocity,
+                                            viewer.yawRate, chunkPrefetcher_.lookahead());
+}
+
+ChunkPriorityContext Terrain::priorityContext(const TerrainViewer& viewer) const {
+    return {
+        .playerPosition = viewer.camera.position,
+        .playerVelocity = viewer.velocity,
+        .predictedPosition = predictedViewerPosition(viewer),
+        .frustum = Frustum::fromCamera(viewer.camera, viewer.aspectRatio),
+        // Keep a one chunk margin, as the scheduler queues chunks for the whole viewer's chunk, and
+        // another one for the neighbours the meshes of the farthest chunks depend on
+        .maxDistance = static_cast<float>((renderDistance_ + 2) * Chunk::SIZE_X),
+    };
+}
+
+bool Terrain::needsReprioritization(const TerrainViewer& viewer) const {
+    constexpr float minDirectionCos = 0.97f;   // About 14 degrees
+    constexpr float maxVelocityChange = 2.0f;  // In blocks per second
+
+    const Camera& camera = viewer.camera;
+    const Vector3 direction = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    return Vector3DotProduct(direction, lastPrioritizedDirection_) < minDirectionCos ||
+           Vector3Distance(viewer.velocity, lastPrioritizedVelocity_) > maxVelocityChange;
+}
+
+void Terrain::scheduleRequests(const TerrainViewer& viewer, const ChunkPriorityContext& context) {
+    const Vector2Int viewerChunk = chunkColumn(viewer.camera.position);
+    const bool rebuilt = terrainScheduler_.update(
+        viewerChunk, renderDistance_, context, [&](const Vector3Int& position) {
+            const bool isLoaded = world_.contains(position);
+            if (isLoaded) chunkPrefetcher_.onChunkEnteredRenderDistance(position);
+            return isLoaded;
+        });
+
+    // Requests dropped by a rebuild of the pending queue must be issued again
+    if (rebuilt) requestMeshes(viewerChunk, context);
+    chunkPrefetcher_.update(
+        context.predictedPosition, viewerChunk, terrainScheduler_.offsets(), renderDistance_,
+        terrainScheduler_.columnHeightChunks(), rebuilt,
+        [&](const Vector3Int& position) { return world_.contains(position); },
+        [&](const Vector3Int& position) { terrainScheduler_.request(position, context); });
+
+    if (rebuilt || needsReprioritization(viewer)) {
+        if (!rebuilt) terrainScheduler_.reprioritize(context);
+        chunksToUpdateTransforms_.reprioritize(context);
+
+        const Camera& camera = viewer.camera;
+        lastPrioritizedDirection_ =
+            Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        lastPrioritizedVelocity_ = viewer.velocity;
+    }
+}
+
+void Terrain::requestMeshes(const Vector2Int& viewerChunk, const ChunkPriorityContext& context) {
+    taskGraph_.beginRound();
+    for (const Vector2Int& offset : terrainScheduler_.offsets()) {
+        const Vector2Int column = viewerChunk + offset;
+        for (int z = 0; z < terrainScheduler_.columnHeightChunks(); z++) {
+            taskGraph_.requestMesh({column.x, column.y, z}, [&](const Vector3Int& dependency) {
+                terrainScheduler_.request(dependency, context);
+            });
+        }
+    }
+    // The meshes left behind are requested again if they come back within the render distance
+    taskGraph_.cancelUnrequestedMeshes();
+}
+
+void Terrain::generatePendingChunks(const size_t maxChunks) {
+    const Clock::time_point start = Clock::now();
+    size_t generatedChunks = 0;
+    while (generatedChunks < maxChunks) {
+        if (isChunkMemoryOverBudget()) {
+            stats_.memoryBudgetStalls++;
+            break;
+        }
+
+        const auto position = terrainScheduler_.popPending();
+        if (!position) break;
+        if (world_.contains(*position)) continue;
+
+        Chunk& chunk = generateChunk(*position);
+        generatedChunks++;
+        if (!isPositionInRenderDistance(chunk.getCenterPosition())) {
+            chunkPrefetcher_.onPrefetchedChunkGenerated(*position);
+        }
+    }
+    stats_.lastGenerationSeconds = secondsSince(start);
+}
+
+void Terrain::queueRunnableMeshes(const ChunkPriorityContext& context) {
+    for (const Vector3Int& position : taskGraph_.takeRunnableMeshes()) {
+        if (!taskGraph_.isMeshed(position)) chunksToUpdateTransforms_.push(position, context);
+    }
+}
+
+void Terrain::updatePendingTransforms(const size_t maxChunks) {
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < maxChunks; i++) {
+        const auto position = chunksToUpdateTransforms_.pop();
+        if (!position) break;
+
+        if (taskGraph_.isMeshed(*position)) continue;
+
+        Chunk* chunk = world_.find(*position);
+        if (!chunk) continue;
+        generateChunkTransforms(*chunk);
+        taskGraph_.completeMesh(*position);
+        meshedChunks_.push_back(*position);
+        stats_.meshedChunks++;
+    }
+    stats_.lastMeshingSeconds += secondsSince(start);
+}
+
+void Terrain::update(const TerrainViewer& viewer, const int renderDistance) {
+    viewerPosition_ = viewer.camera.position;
+    renderDistance_ = renderDistance;
+    meshedChunks_.clear();
+    stats_.lastMeshingSeconds = 0;
+
+    const ChunkPriorityContext context = priorityContext(viewer);
+    scheduleRequests(viewer, context);
+
+    generatePendingChunks(MAX_CHUNKS_GENERATED_PER_UPDATE);
+    remeshEditedChunks();
+    queueRunnableMeshes(context);
+    updatePendingTransforms(MAX_CHUNKS_MESHED_PER_UPDATE);
+    world_.collectRetired();
+
+    if (++updatesSinceHolesSample_ >= HOLES_SAMPLE_INTERVAL_UPDATES) {
+        updatesSinceHolesSample_ = 0;
+        chunkPrefetcher_.sampleHoles(chunkColumn(viewerPosition_), terrainScheduler_.offsets(),
+                                     terrainScheduler_.columnHeightChunks(), context.frustum,
+                                     [&](const Vector3Int& position) {
+                                         return !taskGraph_.isMeshed(position);
+                                     });
+    }
+}
+
+void Terrain::fill(const TerrainViewer& viewer, const int renderDistance) {
+    viewerPosition_ = viewer.camera.position;
+    renderDistance_ = renderDistance;
+    meshedChunks_.clear();
+    stats_.lastMeshingSeconds = 0;
+
+    const double chunksUpperBound = (renderDistance + M_SQRT1_2) * (renderDistance + M_SQRT1_2) *
+                                    M_PI * terrainScheduler_.columnHeightChunks();
+    world_.reserve(world_.size() + static_cast<size_t>(chunksUpperBound));
+    accountWorldMap();
+
+    const ChunkPriorityContext context = priorityContext(viewer);
+    scheduleRequests(viewer, context);
+
+    generatePendingChunks(std::numeric_limits<size_t>::max());
+    remeshEditedChunks();
+    queueRunnableMeshes(context);
+    updatePendingTransforms(std::numeric_limits<size_t>::max());
+    world_.collectRetired();
+}
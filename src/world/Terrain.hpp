@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Chunk.hpp"
+#include "ChunkMap.hpp"
+#include "ChunkPrefetcher.hpp"
+#include "ChunkPriorityQueue.hpp"
+#include "ChunkTaskGraph.hpp"
+#include "LightEngine.hpp"
+#include "TerrainScheduler.hpp"
+#include "absl/container/flat_hash_set.h"
+#include "common/MemoryAccounting.hpp"
+#include "common/UtilityStructures.hpp"
+#include "raylib.h"
+
+// Render distances are radii counted in chunk columns, which must be square
+static_assert(Chunk::SIZE_X == Chunk::SIZE_Y);
+
+/// What the terrain is streamed around
+struct TerrainViewer {
+    Camera camera{};
+    Vector3 velocity{};       // In blocks per second
+    float yawRate = 0.0f;     // In radians per second
+    float aspectRatio = 1.0f;
+};
+
+struct TerrainStats {
+    size_t generatedChunks = 0;        // Since the terrain was created
+    size_t meshedChunks = 0;           // Since the terrain was created
+    size_t remeshedChunks = 0;         // Meshed again after edits, since the terrain was created
+    double lastGenerationSeconds = 0;  // Spent generating chunks by the last update or fill
+    double lastMeshingSeconds = 0;     // Spent generating transforms by the last update or fill,
+                                       // remeshing included
+    size_t memoryBudgetStalls = 0;     // Updates that stopped generating over a memory budget
+};
+
+/// The chunks of the world and the pipeline streaming them in around a viewer: chunk generation,
+/// then transforms generation once the chunk and its neighbours are generated (see
+/// `ChunkTaskGraph`), so that every chunk is meshed once. Chunks are generated lit, and the light
+/// changed by edits spreads to them through `LightEngine`.
+///
+/// Blocks are edited in batches: each edit changes the blocks at once, and the next update remeshes
+/// every chunk the batch changed, through its blocks or its light, once. A meshed chunk is remeshed
+/// as a copy that replaces it in `chunks()`, so that a mesh is never written again once listed.
+///
+/// Nothing here touches the GPU: the chunks whose mesh changed during an update are listed by
+/// `meshedChunks` and uploading them is left to the caller.
+///
+/// The terrain's thread is the one erasing and replacing chunks in `chunks()`: it looks chunks up
+/// without guard, other threads pin a `ChunkMap::ReadGuard`.
+class Terrain {
+   public:
+    constexpr static int MAX_CHUNKS_GENERATED_PER_UPDATE = 64;
+    constexpr static int MAX_CHUNKS_MESHED_PER_UPDATE = 128;
+
+    Terrain(const int seed, const int mapHeightBlocks)
+        : seed_(seed),
+          mapHeightBlocks_(mapHeightBlocks),
+          lightEngine_(world_, mapHeightBlocks),
+          terrainScheduler_(mapHeightBlocks / Chunk::SIZE_Z),
+          taskGraph_(mapHeightBlocks / Chunk::SIZE_Z) {}
+
+    Terrain(const Terrain&) = delete;
+    Terrain& operator=(const Terrain&) = delete;
+
+    ~Terrain() { MemoryAccounting::remove(MemoryCategory::WORLD_MAP, accountedWorldMapBytes_); }
+
+    /// Generates the chunks of the column containing (x, y) and returns the height of the first
+    /// air block from the bottom
+    [[nodiscard]] int generateSpawnColumn(int x, int y);
+
+    /// Streams the terrain in around the viewer, within the per-update budgets
+    void update(const TerrainViewer& viewer, int renderDistance);
+
+    /// Generates and meshes every missing chunk within the render distance of the viewer at once
+    void fill(const TerrainViewer& viewer, int renderDistance);
+
+    /// Sets the block at `position`, in world blocks. Blocks of chunks that are not generated are
+    /// left alone. Returns how many blocks changed.
+    size_t setBlock(const Vector3Int& position, Block block);
+
+    /// Sets the blocks from `min` to `max` included, returns how many changed
+    size_t fillBox(const Vector3Int& min, const Vector3Int& max, Block block);
+
+    /// Sets the blocks whose center is within `radius` of `center`, returns how many changed
+    size_t fillSphere(const Vector3& center, float radius, Block block);
+
+    /// The block at `position`, in world blocks, if its chunk is generated
+    [[nodiscard]] std::optional<Block> findBlock(const Vector3Int& position) const;
+
+    /// Chunks whose transforms were generated by the last `update` or `fill`, after their
+    /// generation or after edits
+    [[nodiscard]] const std::vector<Vector3Int>& meshedChunks() const { return meshedChunks_; }
+
+
+    [[nodiscard]] Chunk* findChunk(const Vector3Int& position) const {
+        return world_.find(position);
+    }
+
+    /// Generated neighbours of the chunk, in the order +X, -X, +Y, -Y, +Z, -Z
+    [[nodiscard]] std::array<OptionalRef<Chunk>, 6> findAdjacentChunks(const Chunk& chunk) const;
+
+    [[nodiscard]] const ChunkMap& chunks() const { return world_; }
+
+    [[nodiscard]] ChunkPrefetcher& prefetcher() { return chunkPrefetcher_; }
+    [[nodiscard]] const ChunkPrefetcher& prefetcher() const { return chunkPrefetcher_; }
+
+    [[nodiscard]] size_t pendingGenerationCount() const {
+        return terrainScheduler_.pendingCount();
+    }
+    [[nodiscard]] size_t pendingTransformsCount() const { return chunksToUpdateTransforms_.size(); }
+    [[nodiscard]] const ChunkTaskGraph& taskGraph() const { return taskGraph_; }
+
+    [[nodiscard]] const TerrainStats& stats() const { return stats_; }
+
+    [[nodiscard]] int seed() const { return seed_; }
+    [[nodiscard]] int mapHeightBlocks() const { return mapHeightBlocks_; }
+
+   private:
+    constexpr static int HOLES_SAMPLE_INTERVAL_UPDATES = 15;
+
+    const int seed_;
+    const int mapHeightBlocks_;
+
+    ChunkMap world_;
+    size_t accountedWorldMapBytes_ = 0;  // Tables of world_, lightEngine_ and taskGraph_
+
+    LightEngine lightEngine_;
+
+    TerrainScheduler terrainScheduler_;
+    ChunkTaskGraph taskGraph_;
+    ChunkPriorityQueue chunksToUpdateTransforms_;  // Runnable mesh jobs
+    ChunkPrefetcher chunkPrefetcher_{};
+    int updatesSinceHolesSample_ = 0;
+
+    std::vector<Vector3Int> meshedChunks_;
+    absl::flat_hash_set<Vector3Int> editedChunks_;  // Whose mesh edits outdated since the update
+
+    // Camera direction and viewer velocity the requests were last prioritized against
+    Vector3 lastPrioritizedDirection_{};
+    Vector3 lastPrioritizedVelocity_{};
+
+    // Viewer and render distance of the current update
+    Vector3 viewerPosition_{};
+    int renderDistance_ = 0;
+
+    TerrainStats stats_{};
+
+    [[nodiscard]] bool isPositionInRenderDistance(const Vector3& position) const;
+
+    Chunk& generateChunk(const Vector3Int& pos);
+
+    /// Reports the memory of the tables of `world_`, the light engine and the task graph after they
+    /// may have grown
+    void accountWorldMap();
+    void generateChunkTransforms(Chunk& chunk) const;
+
+    /// Sets the blocks from `min` to `max` included for which `contains(position)` is true
+    template <typename Contains>
+    size_t editBlocks(const Vector3Int& min, const Vector3Int& max, Block block,
+                      Contains&& contains);
+
+    /// Spreads the light of the edits and remeshes the meshed chunks they changed
+    void remeshEditedChunks();
+
+    [[nodiscard]] static Vector2Int chunkColumn(const Vector3& position);
+    [[nodiscard]] Vector3 predictedViewerPosition(const TerrainViewer& viewer) const;
+    [[nodiscard]] ChunkPriorityContext priorityContext(const TerrainViewer& viewer) const;
+
+    /// Whether the camera turned or the viewer's velocity changed enough since the requests were
+    /// last prioritized
+    [[nodiscard]] bool needsReprioritization(const TerrainViewer& viewer) const;
+
+    /// Updates the pending requests for the current position of the viewer
+    void scheduleRequests(const TerrainViewer& viewer, const ChunkPriorityContext& context);
+
+    /// Requests the meshes of the chunks within the render distance, along with the generation of
+    /// the chunks they depend on
+    void requestMeshes(const Vector2Int& viewerChunk, const ChunkPriorityContext& context);
+
+    /// Generates up to `maxChunks` pending chunks, most urgent first
+    void generatePendingChunks(size_t maxChunks);
+
+    /// Queues the mesh jobs whose dependencies were all generated for transforms generation
+    void queueRunnableMeshes(const ChunkPriorityContext& context);
+
+    /// Generates the transforms of up to `maxChunks` queued chunks, most urgent first
+    void updatePendingTransforms(size_t maxChunks);
+};
@@ -0,0 +1,27 @@
+#include "TerrainScheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+void TerrainScheduler::rebuildOffsets(const int renderDistance) {
+    offsets_.clear();
+
+    // A column is kept if its center can be within the render distance of any point of the
+    // player's chunk, so that moving inside a chunk never reveals a column that was not queued
+    auto distanceToPlayerChunkSq = [](const int dx, const int dy) {
+        const float ex = std::max(0.0f, static_cast<float>(std::abs(dx)) - 0.5f);
+        const float ey = std::max(0.0f, static_cast<float>(std::abs(dy)) - 0.5f);
+        return ex * ex + ey * ey;
+    };
+
+    const auto maxDistanceSq = static_cast<float>(renderDistance * renderDistance);
+    for (int dx = -renderDistance - 1; dx <= renderDistance + 1; dx++) {
+        for (int dy = -renderDistance - 1; dy <= renderDistance + 1; dy++) {
+            if (distanceToPlayerChunkSq(dx, dy) < maxDistanceSq) offsets_.push_back({dx, dy});
+        }
+    }
+
+    std::ranges::stable_sort(offsets_, {}, [](const Vector2Int& offset) {
+        return offset.x * offset.x + offset.y * offset.y;
+    });
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "ChunkPriorityQueue.hpp"
+#include "common/UtilityStructures.hpp"
+
+/// Decides which chunks must be generated around the player.
+///
+/// The set of chunk columns within the render distance is precomputed once per render distance as
+/// a table of offsets sorted by distance (a spiral around the player). The pending queue is only
+/// rebuilt when the player crosses a chunk boundary or the render distance changes, so standing
+/// still costs nothing. Pending chunks are popped by priority (see `ChunkPriorityQueue`).
+class TerrainScheduler {
+   public:
+    explicit TerrainScheduler(const int columnHeightChunks)
+        : columnHeightChunks_(columnHeightChunks) {}
+
+    /// Rebuilds the pending queue if the player changed chunk or the render distance changed.
+    /// Chunks for which `isLoaded` returns true are not queued.
+    ///
+    /// Returns whether the pending queue was rebuilt
+    template <typename IsLoaded>
+    bool update(const Vector2Int& playerChunk, const int renderDistance,
+                const ChunkPriorityContext& context, IsLoaded&& isLoaded) {
+        if (playerChunk == lastPlayerChunk_ && renderDistance == lastRenderDistance_) {
+            return false;
+        }
+
+        if (renderDistance != lastRenderDistance_) rebuildOffsets(renderDistance);
+        lastPlayerChunk_ = playerChunk;
+        lastRenderDistance_ = renderDistance;
+
+        pending_.clear();
+        for (const Vector2Int& offset : offsets_) {
+            const Vector2Int column = playerChunk + offset;
+            for (int z = 0; z < columnHeightChunks_; z++) {
+                const Vector3Int position = {column.x, column.y, z};
+                if (!isLoaded(position)) pending_.push(position, context);
+            }
+        }
+        return true;
+    }
+
+    /// Queues a chunk outside of the regular render distance, e.g. for prefetching
+    void request(const Vector3Int& position, const ChunkPriorityContext& context) {
+        pending_.push(position, context);
+    }
+
+    /// Pops the most urgent pending chunk position, if any
+    [[nodiscard]] std::optional<Vector3Int> popPending() { return pending_.pop(); }
+
+    /// Recomputes the priorities of the pending chunks, e.g. after the camera turned
+    void reprioritize(const ChunkPriorityContext& context) { pending_.reprioritize(context); }
+
+    [[nodiscard]] size_t pendingCount() const { return pending_.size(); }
+    [[nodiscard]] int columnHeightChunks() const { return columnHeightChunks_; }
+
+    /// Column offsets (in chunks) around the player's chunk, sorted by increasing distance
+    [[nodiscard]] const std::vector<Vector2Int>& offsets() const { return offsets_; }
+
+   private:
+    const int columnHeightChunks_;
+
+    std::vector<Vector2Int> offsets_;
+
+    ChunkPriorityQueue pending_;
+
+    Vector2Int lastPlayerChunk_{};
+    int lastRenderDistance_ = -1;
+
+    void rebuildOffsets(int renderDistance);
+};
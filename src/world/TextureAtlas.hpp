@@ -5,3 +5,7 @@ const std::string TEXTURE_ATLAS_PATH =
     std::string(CMAKE_ROOT_DIR) + "/resources/textures/atlas.png";
 
 constexpr int TEXTURE_SIZE = 16;  // Size of each texture in the atlas
+
+// Size of the atlas image, for when it is not loaded (e.g. headless runs)
+constexpr int TEXTURE_ATLAS_WIDTH = 7 * TEXTURE_SIZE;
+constexpr int TEXTURE_ATLAS_HEIGHT = TEXTURE_SIZE;
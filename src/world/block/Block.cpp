@@ -2,10 +2,11 @@
 
 #include <array>
 
+template <typename Index>
 void Block::generateBlockMesh(const Vector3Int& position, std::vector<Vertex>& chunkMeshVerts,
-                              std::vector<uint16_t>& chunkMeshIndices_,
+                              std::vector<Index>& chunkMeshIndices_,
                               const std::array<bool, 6>& isFaceVisible,
-                              const Texture2D& textureAtlas) const {
+                              const std::array<uint8_t, 6>& faceLights) const {
     if (!isRendered()) return;
 
     struct Face {
@@ -28,38 +29,25 @@ void Block::generateBlockMesh(const Vector3Int& position, std::vector<Vertex>& c
         // +Z (top)
         {{0, 0, 1}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
         // -Z (bottom)
-        {{0, 1, 0}, {-1, 0, 0}, {0, -1, 0}, {0, 0, -1}},
+        {{0, 1, 0}, {1, 0, 0}, {0, -1, 0}, {0, 0, -1}},
     };
 
     auto appendQuad = [&](const Vector3Int& origin, const Vector3Int& edgeDirU,
-                          const Vector3Int& edgeDirV, const Vector3Int& faceNormal) {
-        const int startIndex = static_cast<int>(chunkMeshVerts.size());
+                          const Vector3Int& edgeDirV, const Vector3Int& faceNormal,
+                          const FaceUVs& uvs, const uint8_t light) {
+        // A quad never straddles two submeshes, their size being a multiple of its 4 vertices
+        const int startIndex =
+            static_cast<int>(chunkMeshVerts.size() % MAX_SUBMESH_VERTICES<Index>);
 
-        Rectangle textureRect;
-        if (faceNormal == Vector3Int{0, 0, 1}) {
-            textureRect = textureRectTop();
-        } else if (faceNormal == Vector3Int{0, 0, -1}) {
-            textureRect = textureRectBottom();
-        } else [[likely]] {
-            textureRect = textureRectSides();
-        }
+        const Vector2 textureCoordBL{uvs.u0, uvs.v0};
+        const Vector2 textureCoordBR{uvs.u1, uvs.v0};
+        const Vector2 textureCoordTR{uvs.u1, uvs.v1};
+        const Vector2 textureCoordTL{uvs.u0, uvs.v1};
 
-        const float u0 = textureRect.x / static_cast<float>(textureAtlas.width);
-        const float u1 =
-            (textureRect.x + textureRect.width) / static_cast<float>(textureAtlas.width);
-        const float v0 = 1.0f - textureRect.y / static_cast<float>(textureAtlas.height);
-        const float v1 =
-            1.0f - (textureRect.y + textureRect.height) / static_cast<float>(textureAtlas.height);
-
-        const Vector2 textureCoordBL{u0, v0};
-        const Vector2 textureCoordBR{u1, v0};
-        const Vector2 textureCoordTR{u1, v1};
-        const Vector2 textureCoordTL{u0, v1};
-
-        chunkMeshVerts.push_back({origin, faceNormal, textureCoordBL});
-        chunkMeshVerts.push_back({origin + edgeDirU, faceNormal, textureCoordBR});
-        chunkMeshVerts.push_back({origin + edgeDirU + edgeDirV, faceNormal, textureCoordTR});
-        chunkMeshVerts.push_back({origin + edgeDirV, faceNormal, textureCoordTL});
+        chunkMeshVerts.push_back({origin, faceNormal, textureCoordBL, light});
+        chunkMeshVerts.push_back({origin + edgeDirU, faceNormal, textureCoordBR, light});
+        chunkMeshVerts.push_back({origin + edgeDirU + edgeDirV, faceNormal, textureCoordTR, light});
+        chunkMeshVerts.push_back({origin + edgeDirV, faceNormal, textureCoordTL, light});
 
         chunkMeshIndices_.push_back(startIndex + 0);
         chunkMeshIndices_.push_back(startIndex + 1);
@@ -77,6 +65,13 @@ void Block::generateBlockMesh(const Vector3Int& position, std::vector<Vertex>& c
         const Vector3Int origin = {position.x + face.originOffset.x,
                                    position.y + face.originOffset.y,
                                    position.z + face.originOffset.z};
-        appendQuad(origin, face.u, face.v, face.normal);
+        appendQuad(origin, face.u, face.v, face.normal, getFaceUVs(type_, i), faceLights[i]);
     }
 }
+
+template void Block::generateBlockMesh(const Vector3Int&, std::vector<Vertex>&,
+                                       std::vector<uint16_t>&, const std::array<bool, 6>&,
+                                       const std::array<uint8_t, 6>&) const;
+template void Block::generateBlockMesh(const Vector3Int&, std::vector<Vertex>&,
+                                       std::vector<uint32_t>&, const std::array<bool, 6>&,
+                                       const std::array<uint8_t, 6>&) const;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BlockData.hpp"
+#include "BlockRegistry.hpp"
+#include "BlockType.hpp"
+
+/// Most vertices in a submesh of a chunk mesh indexed with `Index`. The indices of a face count
+/// from the first vertex of its submesh, so that they fit `Index` however many faces there are.
+template <typename Index>
+constexpr size_t MAX_SUBMESH_VERTICES = size_t{std::numeric_limits<Index>::max()} + 1;
+
+class Block {
+   public:
+    Block() = default;
+    explicit Block(const BlockType type) : type_(type) {}
+
+    [[nodiscard]] bool isRendered() const { return blockTypeData().isRendered; }
+    [[nodiscard]] uint8_t lightEmission() const { return blockTypeData().lightEmission; }
+    [[nodiscard]] BlockType type() const { return type_; }
+
+    // isFaceVisible and faceLights (packed) faces in order: +X, -X, +Y, -Y, +Z, -Z. Index is
+    // uint16_t or uint32_t, see `MAX_SUBMESH_VERTICES`.
+    template <typename Index>
+    void generateBlockMesh(const Vector3Int& position, std::vector<Vertex>& chunkMeshVerts,
+                           std::vector<Index>& chunkMeshIndices_,
+                           const std::array<bool, 6>& isFaceVisible,
+                           const std::array<uint8_t, 6>& faceLights) const;
+
+   private:
+    BlockType type_ = BlockType::BLOCK_AIR;
+
+    [[nodiscard]] const BlockTypeData& blockTypeData() const { return getBlockTypeData(type_); }
+};
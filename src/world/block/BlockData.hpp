@@ -11,7 +11,8 @@ struct BlockTypeData {
     const Vector2Int textureAtlasPositionTop{};
     const Vector2Int textureAtlasPositionBottom{};
     const Vector2Int textureAtlasPositionSides{};
-    const bool isRendered = true;
+    const bool isRendered = true;  // Rendered blocks also stop light
+    const uint8_t lightEmission = 0;
 };
 
 constexpr Vector3 FULL_BLOCK_SIZE{1.0f, 1.0f, 1.0f};
@@ -22,7 +23,12 @@ static constexpr BlockTypeData BLOCK_DATA[] = {
     {FULL_BLOCK_SIZE, Vector2Int{2, 0}, Vector2Int{2, 0}, Vector2Int{2, 0}},  // BLOCK_DIRT
     {FULL_BLOCK_SIZE, Vector2Int{3, 0}, Vector2Int{3, 0}, Vector2Int{3, 0}},  // BLOCK_STONE
     {FULL_BLOCK_SIZE, Vector2Int{4, 0}, Vector2Int{4, 0}, Vector2Int{4, 0}},  // BLOCK_SAND
-    {FULL_BLOCK_SIZE, Vector2Int{5, 0}, Vector2Int{5, 0}, Vector2Int{5, 0}}   // BLOCK_WATER
+    {FULL_BLOCK_SIZE, Vector2Int{5, 0}, Vector2Int{5, 0}, Vector2Int{5, 0}},  // BLOCK_WATER
+    {.size = FULL_BLOCK_SIZE,
+     .textureAtlasPositionTop = Vector2Int{6, 0},
+     .textureAtlasPositionBottom = Vector2Int{6, 0},
+     .textureAtlasPositionSides = Vector2Int{6, 0},
+     .lightEmission = 14},  // BLOCK_LAMP
 };
 
 inline const BlockTypeData& getBlockTypeData(const BlockType type) {
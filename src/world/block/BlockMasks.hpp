@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "Block.hpp"
+#include "BlockData.hpp"
+
+/// One bit per block of a row of up to 64 blocks, bit i for block i
+template <size_t Size>
+using BlockRowMask = std::conditional_t<(Size <= 32), uint32_t, uint64_t>;
+
+// The vector path reads blocks as their type bytes and looks types up in a 16 byte table
+static_assert(sizeof(Block) == sizeof(BlockType));
+static_assert(std::size(BLOCK_DATA) <= 16);
+
+/// Which blocks of the row are rendered. With AVX2, 32 blocks are classified at once by a byte
+/// shuffle against the table of rendered types and a move mask.
+template <size_t Size>
+[[nodiscard]] BlockRowMask<Size> renderedMask(const std::array<Block, Size>& row) {
+    static_assert(Size <= 64);
+    using Mask = BlockRowMask<Size>;
+
+    Mask mask = 0;
+    size_t i = 0;
+#ifdef __AVX2__
+    // 0xff for the rendered block types, indexed by type
+    static constexpr std::array<uint8_t, 16> RENDERED_TYPES = [] {
+        std::array<uint8_t, 16> table{};
+        for (size_t type = 0; type < std::size(BLOCK_DATA); type++) {
+            table[type] = BLOCK_DATA[type].isRendered ? 0xff : 0x00;
+        }
+        return table;
+    }();
+    const auto* types = reinterpret_cast<const uint8_t*>(row.data());
+    const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(RENDERED_TYPES.data()));
+    for (; i + 32 <= Size; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+        const __m256i rendered = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(table), bytes);
+        mask |= static_cast<Mask>(static_cast<uint32_t>(_mm256_movemask_epi8(rendered))) << i;
+    }
+    for (; i + 16 <= Size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + i));
+        const __m128i rendered = _mm_shuffle_epi8(table, bytes);
+        mask |= static_cast<Mask>(static_cast<uint32_t>(_mm_movemask_epi8(rendered))) << i;
+    }
+#endif
+    for (; i < Size; i++) {
+        mask |= static_cast<Mask>(row[i].isRendered()) << i;
+    }
+    return mask;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "BlockData.hpp"
+#include "BlockType.hpp"
+#include "world/TextureAtlas.hpp"
+
+/// Normalized texture coordinates of a face's texture in the atlas, (u0, v0) being the corner of
+/// the face's origin and (u1, v1) the opposite one
+struct FaceUVs {
+    float u0, v0, u1, v1;
+};
+
+constexpr size_t BLOCK_TYPE_COUNT = std::size(BLOCK_DATA);
+constexpr int BLOCK_FACE_COUNT = 6;  // +X, -X, +Y, -Y, +Z, -Z, as in the mesher
+
+/// Texture coordinates of the texture at the given position in the atlas, in textures
+constexpr FaceUVs atlasFaceUVs(const Vector2Int& atlasPosition) {
+    constexpr auto width = static_cast<float>(TEXTURE_ATLAS_WIDTH);
+    constexpr auto height = static_cast<float>(TEXTURE_ATLAS_HEIGHT);
+    const auto x = static_cast<float>(atlasPosition.x * TEXTURE_SIZE);
+    const auto y = static_cast<float>(atlasPosition.y * TEXTURE_SIZE);
+    return {x / width, 1.0f - y / height, (x + TEXTURE_SIZE) / width,
+            1.0f - (y + TEXTURE_SIZE) / height};
+}
+
+constexpr bool isInTextureAtlas(const Vector2Int& atlasPosition) {
+    return atlasPosition.x >= 0 && atlasPosition.y >= 0 &&
+           (atlasPosition.x + 1) * TEXTURE_SIZE <= TEXTURE_ATLAS_WIDTH &&
+           (atlasPosition.y + 1) * TEXTURE_SIZE <= TEXTURE_ATLAS_HEIGHT;
+}
+
+/// Texture coordinates of every face of every block type, computed at compile time from
+/// `BLOCK_DATA` and the atlas dimensions: adding a block type only takes a `BLOCK_DATA` entry
+constexpr std::array<std::array<FaceUVs, BLOCK_FACE_COUNT>, BLOCK_TYPE_COUNT> BLOCK_FACE_UVS = [] {
+    std::array<std::array<FaceUVs, BLOCK_FACE_COUNT>, BLOCK_TYPE_COUNT> table{};
+    for (size_t type = 0; type < BLOCK_TYPE_COUNT; type++) {
+        const BlockTypeData& data = BLOCK_DATA[type];
+        for (int face = 0; face < BLOCK_FACE_COUNT; face++) {
+            const Vector2Int& position = face == 4   ? data.textureAtlasPositionTop
+                                         : face == 5 ? data.textureAtlasPositionBottom
+                                                     : data.textureAtlasPositionSides;
+            table[type][face] = atlasFaceUVs(position);
+        }
+    }
+    return table;
+}();
+
+static_assert(
+    [] {
+        for (const BlockTypeData& data : BLOCK_DATA) {
+            if (!data.isRendered) continue;
+            if (!isInTextureAtlas(data.textureAtlasPositionTop) ||
+                !isInTextureAtlas(data.textureAtlasPositionBottom) ||
+                !isInTextureAtlas(data.textureAtlasPositionSides)) {
+                return false;
+            }
+        }
+        return true;
+    }(),
+    "A rendered block type has a texture outside of the atlas");
+
+inline const FaceUVs& getFaceUVs(const BlockType type, const int face) {
+    return BLOCK_FACE_UVS[static_cast<std::underlying_type_t<BlockType>>(type)][face];
+}
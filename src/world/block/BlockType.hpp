@@ -8,6 +8,7 @@ struct Vertex {
     Vector3Int position;
     Vector3Int normal;
     Vector2 textureCoord;
+    uint8_t light;  // Of the face: sky light in the high nibble, block light in the low one
 };
 
 enum class BlockType : uint8_t {
@@ -17,4 +18,5 @@ enum class BlockType : uint8_t {
     BLOCK_STONE = 3,
     BLOCK_SAND = 4,
     BLOCK_WATER = 5,
+    BLOCK_LAMP = 6,
 };
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "world/Terrain.hpp"
+
+// Shared by the tests and the benchmarks
+
+/// A viewer at `position` looking along +Y, level, with the game's field of view
+inline TerrainViewer viewerAt(const Vector3& position) {
+    TerrainViewer viewer{};
+    viewer.camera.position = position;
+    viewer.camera.target = {position.x, position.y + 1.0f, position.z};
+    viewer.camera.up = {0.0f, 0.0f, 1.0f};
+    viewer.camera.fovy = 80.0f;
+    return viewer;
+}
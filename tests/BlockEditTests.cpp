@@ -0,0 +1,184 @@
+#include <array>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "MeshSurface.hpp"
+#include "Test.hpp"
+#include "absl/container/flat_hash_set.h"
+#include "raymath.h"
+#include "testing/Viewers.hpp"
+#include "world/Chunk.hpp"
+#include "world/Terrain.hpp"
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 128;
+
+}  // namespace
+
+TEST(chunkOccupancyFollowsEdits) {
+    Chunk chunk(0, 0, 0);
+    CHECK(chunk.isEmpty());
+
+    chunk.setBlock({3, 4, 5}, Block{BlockType::BLOCK_STONE});
+    chunk.setBlock({3, 4, 6}, Block{BlockType::BLOCK_LAMP});
+    CHECK(!chunk.isEmpty());
+    CHECK(chunk.isColumnOccupied(3, 4));
+    CHECK(!chunk.isColumnOccupied(4, 3));
+
+    chunk.setBlock({3, 4, 5}, Block{BlockType::BLOCK_AIR});
+    CHECK(chunk.isColumnOccupied(3, 4));
+    chunk.setBlock({3, 4, 6}, Block{BlockType::BLOCK_AIR});
+    CHECK(!chunk.isColumnOccupied(3, 4));
+    CHECK(chunk.isEmpty());
+}
+
+TEST(chunkCopiesKeepBlocksLightAndOccupancy) {
+    Chunk chunk(3, -2, 1);
+    chunk.generate(SEED, MAP_HEIGHT_BLOCKS);
+    chunk.generateTransforms(std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                             std::nullopt);
+
+    const auto copy = chunk.copyWithoutMesh();
+    CHECK(copy->getX() == 3 && copy->getY() == -2 && copy->getZ() == 1);
+    CHECK(copy->getMeshVertices().empty());
+    CHECK(copy->isLightUniform() == chunk.isLightUniform());
+    for (int x = 0; x < Chunk::SIZE_X; x++) {
+        for (int y = 0; y < Chunk::SIZE_Y; y++) {
+            CHECK(copy->isColumnOccupied(x, y) == chunk.isColumnOccupied(x, y));
+            bool isOccupied = false;
+            for (int z = 0; z < Chunk::SIZE_Z; z++) {
+                CHECK(copy->getData()[x][y][z].type() == chunk.getData()[x][y][z].type());
+                CHECK(copy->getLight({x, y, z}) == chunk.getLight({x, y, z}));
+                isOccupied |= chunk.getData()[x][y][z].isRendered();
+            }
+            CHECK(chunk.isColumnOccupied(x, y) == isOccupied);
+        }
+    }
+}
+
+TEST(sphereEditRemeshesEveryTouchedChunkOnce) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    const TerrainViewer viewer = viewerAt({0.5f, 0.5f, 100.0f});
+    terrain.fill(viewer, 4);
+
+    // Around the corner of four columns of chunks, from the bottom of the world to the sky
+    const Vector3 center = {0.0f, 0.0f, 40.0f};
+    constexpr float radius = 56.0f;
+    absl::flat_hash_set<Vector3Int> changedChunks;
+    for (int x = -56; x < 56; x++) {
+        for (int y = -56; y < 56; y++) {
+            for (int z = 0; z < 96; z++) {
+                const Vector3 blockCenter = {x + 0.5f, y + 0.5f, z + 0.5f};
+                if (Vector3DistanceSqr(blockCenter, center) <= radius * radius &&
+                    terrain.findBlock({x, y, z})->type() != BlockType::BLOCK_STONE) {
+                    changedChunks.insert(Chunk::chunkOf({x, y, z}));
+                }
+            }
+        }
+    }
+    const Block outside = *terrain.findBlock({0, 57, 24});
+    CHECK(terrain.fillSphere(center, radius, Block{BlockType::BLOCK_STONE}) > 0);
+    CHECK(terrain.findBlock({0, 0, 95})->type() == BlockType::BLOCK_STONE);
+    CHECK(terrain.findBlock({0, 57, 24})->type() == outside.type());
+    CHECK(!terrain.findBlock({0, 0, -1}));
+
+    const size_t remeshedBefore = terrain.stats().remeshedChunks;
+    terrain.update(viewer, 4);
+    const std::vector<Vector3Int>& meshed = terrain.meshedChunks();
+    const absl::flat_hash_set<Vector3Int> distinct(meshed.begin(), meshed.end());
+    CHECK(distinct.size() == meshed.size());
+    CHECK(terrain.stats().remeshedChunks - remeshedBefore == meshed.size());
+    CHECK(changedChunks.size() >= 30);
+    for (const Vector3Int& position : changedChunks) CHECK(distinct.contains(position));
+
+    // Remeshing in place of a mesh from scratch builds the same mesh
+    for (const Vector3Int& position : meshed) {
+        const Chunk& chunk = *terrain.findChunk(position);
+        const auto fresh = chunk.copyWithoutMesh();
+        const auto neighbours = terrain.findAdjacentChunks(chunk);
+        fresh->generateTransforms(neighbours[0], neighbours[1], neighbours[2], neighbours[3],
+                                  neighbours[4], neighbours[5]);
+        CHECK(fresh->getMeshVertices() == chunk.getMeshVertices());
+        CHECK(fresh->getMeshColors() == chunk.getMeshColors());
+    }
+
+    // Nothing is left for the next update
+    terrain.update(viewer, 4);
+    CHECK(terrain.meshedChunks().empty());
+}
+
+TEST(remeshingLeavesTheMeshesBeingReadAlone) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    const TerrainViewer viewer = viewerAt({0.5f, 0.5f, 100.0f});
+    terrain.fill(viewer, 2);
+    const int ground = terrain.generateSpawnColumn(0, 0);
+    const Vector3Int position = {0, 0, (ground - 1) / Chunk::SIZE_Z};
+
+    const ChunkMap::ReadGuard guard = terrain.chunks().pin();
+    const Chunk* reading = terrain.chunks().find(position, guard);
+    const std::vector<float> vertices = reading->getMeshVertices();
+
+    CHECK(terrain.fillBox({4, 4, ground - 3}, {6, 6, ground - 1}, Block{BlockType::BLOCK_AIR}) ==
+          27);
+    terrain.update(viewer, 2);
+
+    const Chunk* remeshed = terrain.chunks().find(position, guard);
+    CHECK(remeshed != reading);
+    CHECK(reading->getMeshVertices() == vertices);
+    CHECK(remeshed->getMeshVertices() != vertices);
+    CHECK(terrain.findBlock({5, 5, ground - 2})->type() == BlockType::BLOCK_AIR);
+}
+
+TEST(editsShowingMoreFacesThanIndicesCountAreMeshedInSubmeshes) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    const TerrainViewer viewer = viewerAt({0.5f, 0.5f, 100.0f});
+    terrain.fill(viewer, 2);
+
+    // Stone at every other block of a chunk in the sky, each showing its 6 faces: 16^3 * 6 * 4
+    // vertices, more than 16-bit indices reach
+    const Vector3Int position = {0, 0, MAP_HEIGHT_BLOCKS / Chunk::SIZE_Z - 1};
+    const Vector3Int first = {0, 0, position.z * Chunk::SIZE_Z};
+    const Vector3Int last = {Chunk::SIZE_X - 1, Chunk::SIZE_Y - 1, first.z + Chunk::SIZE_Z - 1};
+    (void)terrain.fillBox(first, last, Block{BlockType::BLOCK_STONE});
+    for (int i = 1; i < Chunk::SIZE_X; i += 2) {
+        const Block air{BlockType::BLOCK_AIR};
+        (void)terrain.fillBox({i, first.y, first.z}, {i, last.y, last.z}, air);
+        (void)terrain.fillBox({first.x, i, first.z}, {last.x, i, last.z}, air);
+        (void)terrain.fillBox({first.x, first.y, first.z + i}, {last.x, last.y, first.z + i}, air);
+    }
+    terrain.update(viewer, 2);
+
+    const Chunk& chunk = *terrain.findChunk(position);
+    const size_t vertexCount = chunk.getMeshVertices().size() / 3;
+    CHECK(vertexCount > size_t{std::numeric_limits<Chunk::MeshIndex>::max()} + 1);
+    CHECK(chunk.submeshCount() == 2);
+
+    size_t submeshVertices = 0;
+    size_t submeshIndices = 0;
+    bool areIndicesInSubmesh = true;
+    for (size_t i = 0; i < chunk.submeshCount(); i++) {
+        const Chunk::Submesh submesh = chunk.getSubmesh(i);
+        CHECK(submesh.firstVertex == submeshVertices && submesh.firstIndex == submeshIndices);
+        for (size_t index = 0; index < submesh.indexCount; index++) {
+            areIndicesInSubmesh &=
+                chunk.getMeshIndices()[submesh.firstIndex + index] < submesh.vertexCount;
+        }
+        submeshVertices += submesh.vertexCount;
+        submeshIndices += submesh.indexCount;
+    }
+    CHECK(areIndicesInSubmesh);
+    CHECK(submeshVertices == vertexCount);
+    CHECK(submeshIndices == chunk.getMeshIndices().size());
+
+    std::array<const Chunk*, 6> neighbours{};
+    const std::array<OptionalRef<Chunk>, 6> adjacent = terrain.findAdjacentChunks(chunk);
+    for (size_t i = 0; i < neighbours.size(); i++) {
+        neighbours[i] = adjacent[i] ? &adjacent[i]->get() : nullptr;
+    }
+    const MeshSurface surface = meshSurface(chunk);
+    CHECK(surface.overlaps == 0 && surface.invalidTriangles == 0);
+    CHECK(surface == expectedSurface(chunk, neighbours));
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Test.hpp"
+#include "common/MemoryAccounting.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkMap.hpp"
+
+namespace {
+
+std::unique_ptr<Chunk> makeChunk(const Vector3Int& position) {
+    return std::make_unique<Chunk>(position.x, position.y, position.z);
+}
+
+Vector3Int positionOf(const int i) { return {i % 7 - 3, i / 7 - 10, i % 3}; }
+
+}  // namespace
+
+TEST(chunkMapFindsInsertedChunksUntilErased) {
+    constexpr int count = 300;
+    ChunkMap map;
+    for (int i = 0; i < count; i++) CHECK(map.insert(makeChunk(positionOf(i))).second);
+    CHECK(map.size() == count);
+
+    auto [existing, isInserted] = map.insert(makeChunk(positionOf(5)));
+    CHECK(!isInserted);
+    CHECK(&existing == map.find(positionOf(5)));
+
+    for (int i = 0; i < count; i += 2) CHECK(map.erase(positionOf(i)));
+    CHECK(!map.erase(positionOf(0)));
+    CHECK(map.size() == count / 2);
+    for (int i = 0; i < count; i++) {
+        const Chunk* chunk = map.find(positionOf(i));
+        CHECK((chunk != nullptr) == (i % 2 == 1));
+        if (chunk) CHECK(Vector3Int{chunk->getX(), chunk->getY(), chunk->getZ()} == positionOf(i));
+    }
+
+    size_t visited = 0;
+    map.forEach([&](const Chunk&) { visited++; });
+    CHECK(visited == count / 2);
+}
+
+TEST(erasedChunksLiveAsLongAsTheGuardsThatCanSeeThem) {
+    ChunkMap map;
+    (void)map.insert(makeChunk({0, 0, 0}));
+    const size_t bytes = MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA);
+    {
+        const ChunkMap::ReadGuard guard = map.pin();
+        const Chunk* chunk = map.find({0, 0, 0}, guard);
+        CHECK(chunk != nullptr);
+
+        CHECK(map.erase({0, 0, 0}));
+        map.collectRetired();
+        CHECK(map.find({0, 0, 0}, guard) == nullptr);
+        CHECK(MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA) == bytes);
+        CHECK(chunk->getX() == 0);
+    }
+    map.collectRetired();
+    CHECK(MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA) == bytes - sizeof(Chunk::ChunkData));
+}
+
+TEST(replacedChunksLiveAsLongAsTheGuardsThatCanSeeThem) {
+    ChunkMap map;
+    CHECK(!map.replace(makeChunk({0, 0, 0})));
+    (void)map.insert(makeChunk({0, 0, 0}));
+    {
+        const ChunkMap::ReadGuard guard = map.pin();
+        const Chunk* replaced = map.find({0, 0, 0}, guard);
+
+        auto replacement = makeChunk({0, 0, 0});
+        const Chunk* replacing = replacement.get();
+        CHECK(map.replace(std::move(replacement)));
+        map.collectRetired();
+        CHECK(map.find({0, 0, 0}, guard) == replacing);
+        CHECK(map.size() == 1);
+        CHECK(replaced->getX() == 0);
+    }
+    map.collectRetired();
+    CHECK(map.size() == 1);
+}
+
+// Meant to run under ThreadSanitizer as well, see README
+TEST(chunkMapStressReadsWhileChunksAreInsertedAndErased) {
+    constexpr int readers = 3;
+    constexpr int rounds = 2000;
+    constexpr int window = 64;  // Chunks alive at once
+
+    ChunkMap map;
+    std::atomic<bool> isDone = false;
+    std::atomic<int> mismatches = 0;
+    std::vector<std::thread> threads;
+    for (int reader = 0; reader < readers; reader++) {
+        threads.emplace_back([&, reader] {
+            for (int i = reader; !isDone.load(std::memory_order_relaxed); i++) {
+                const ChunkMap::ReadGuard guard = map.pin();
+                const Vector3Int position = positionOf(i % (rounds + window));
+                const Chunk* chunk = map.find(position, guard);
+                if (chunk && (chunk->getX() != position.x || chunk->getY() != position.y ||
+                              chunk->getZ() != position.z ||
+                              chunk->getData()[1][2][3].type() != BlockType::BLOCK_AIR)) {
+                    mismatches.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // The owner slides a window of chunks, growing and shrinking the tables
+    int erased = 0;
+    for (int i = 0; i < rounds + window; i++) {
+        if (i < rounds) (void)map.insert(makeChunk(positionOf(i)));
+        if (i >= window) erased += map.erase(positionOf(i - window));
+    }
+    isDone = true;
+    for (std::thread& thread : threads) thread.join();
+
+    CHECK(mismatches == 0);
+    CHECK(erased == rounds);
+    CHECK(map.empty());
+}
@@ -0,0 +1,22 @@
+#include <cmath>
+#include <numbers>
+
+#include "Test.hpp"
+#include "world/ChunkPrefetcher.hpp"
+
+TEST(predictionFollowsTheArcOfATurn) {
+    constexpr float pi = std::numbers::pi_v<float>;
+
+    // Straight ahead, and climbing
+    Vector3 predicted = ChunkPrefetcher::predictPosition({1, 2, 3}, {10, 0, 1}, 0.0f, 2.0f);
+    CHECK(std::abs(predicted.x - 21.0f) < 1e-4f && std::abs(predicted.y - 2.0f) < 1e-4f);
+    CHECK(std::abs(predicted.z - 5.0f) < 1e-4f);
+
+    // Half a circle of radius 1: across its diameter, perpendicular to the initial heading
+    predicted = ChunkPrefetcher::predictPosition({0, 0, 0}, {pi, 0, 0}, pi, 1.0f);
+    CHECK(std::abs(predicted.x) < 1e-4f && std::abs(predicted.y - 2.0f) < 1e-4f);
+
+    // A quarter turn the other way
+    predicted = ChunkPrefetcher::predictPosition({0, 0, 0}, {0, pi / 2, 0}, -pi / 2, 1.0f);
+    CHECK(std::abs(predicted.x - 1.0f) < 1e-4f && std::abs(predicted.y - 1.0f) < 1e-4f);
+}
@@ -0,0 +1,62 @@
+#include "Test.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkPriorityQueue.hpp"
+
+namespace {
+
+ChunkPriorityContext contextAt(const Vector3& position, const float maxDistance) {
+    return {
+        .playerPosition = position,
+        .predictedPosition = position,
+        .maxDistance = maxDistance,
+    };
+}
+
+}  // namespace
+
+TEST(popsClosestFirst) {
+    const ChunkPriorityContext context = contextAt({0, 0, 0}, 1000.0f);
+    ChunkPriorityQueue queue;
+    queue.push({5, 0, 0}, context);
+    queue.push({1, 0, 0}, context);
+    queue.push({3, 0, 0}, context);
+
+    CHECK(queue.pop() == Vector3Int{1, 0, 0});
+    CHECK(queue.pop() == Vector3Int{3, 0, 0});
+    CHECK(queue.pop() == Vector3Int{5, 0, 0});
+    CHECK(!queue.pop().has_value());
+}
+
+TEST(pushIgnoresDuplicates) {
+    const ChunkPriorityContext context = contextAt({0, 0, 0}, 1000.0f);
+    ChunkPriorityQueue queue;
+    queue.push({2, 2, 0}, context);
+    queue.push({2, 2, 0}, context);
+
+    CHECK(queue.size() == 1);
+    CHECK(queue.contains({2, 2, 0}));
+    (void)queue.pop();
+    CHECK(!queue.contains({2, 2, 0}));
+}
+
+TEST(reprioritizeCancelsOutOfRange) {
+    ChunkPriorityQueue queue;
+    queue.push({1, 0, 0}, contextAt({0, 0, 0}, 1000.0f));
+    queue.push({20, 0, 0}, contextAt({0, 0, 0}, 1000.0f));
+
+    queue.reprioritize(contextAt({0, 0, 0}, 4.0f * Chunk::SIZE_X));
+
+    CHECK(queue.size() == 1);
+    CHECK(queue.cancelledCount() == 1);
+    CHECK(queue.pop() == Vector3Int{1, 0, 0});
+}
+
+TEST(reprioritizeFollowsThePlayer) {
+    ChunkPriorityQueue queue;
+    queue.push({1, 0, 0}, contextAt({0, 0, 0}, 1000.0f));
+    queue.push({8, 0, 0}, contextAt({0, 0, 0}, 1000.0f));
+
+    queue.reprioritize(contextAt(Chunk::getCenterPosition(8, 0, 0), 1000.0f));
+
+    CHECK(queue.pop() == Vector3Int{8, 0, 0});
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <vector>
+
+#include "Test.hpp"
+#include "world/ChunkTaskGraph.hpp"
+
+namespace {
+
+/// Requests the mesh of the chunk and returns the generation jobs it was scheduled to wait for
+std::vector<Vector3Int> requestMesh(ChunkTaskGraph& graph, const Vector3Int& position) {
+    std::vector<Vector3Int> scheduled;
+    graph.requestMesh(position, [&](const Vector3Int& dependency) {
+        scheduled.push_back(dependency);
+    });
+    return scheduled;
+}
+
+}  // namespace
+
+TEST(meshRunsOnceItsNeighbourhoodIsGenerated) {
+    ChunkTaskGraph graph(4);
+    const std::vector<Vector3Int> dependencies = requestMesh(graph, {0, 0, 1});
+    CHECK(dependencies.size() == 7);
+
+    for (const Vector3Int& dependency : dependencies) {
+        CHECK(graph.takeRunnableMeshes().empty());
+        graph.completeGeneration(dependency);
+    }
+    CHECK(graph.takeRunnableMeshes() == std::vector<Vector3Int>{{0, 0, 1}});
+    CHECK(graph.waitingMeshCount() == 0);
+}
+
+TEST(meshDoesNotWaitBeyondTheColumn) {
+    ChunkTaskGraph graph(1);
+    const std::vector<Vector3Int> dependencies = requestMesh(graph, {0, 0, 0});
+    CHECK(dependencies.size() == 5);
+    CHECK(std::ranges::none_of(dependencies, [](const Vector3Int& d) { return d.z != 0; }));
+}
+
+TEST(generationReleasesEveryDependent) {
+    ChunkTaskGraph graph(1);
+    for (int x = -2; x <= 2; x++) {
+        for (int y = -2; y <= 2; y++) {
+            if (x != 0 || y != 0) graph.completeGeneration({x, y, 0});
+        }
+    }
+
+    // Only the center is missing for the chunk and its four neighbours
+    for (const Vector3Int& position :
+         {Vector3Int{0, 0, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}}) {
+        CHECK(requestMesh(graph, position) == std::vector<Vector3Int>{{0, 0, 0}});
+    }
+    CHECK(graph.waitingMeshCount() == 5);
+
+    graph.completeGeneration({0, 0, 0});
+    CHECK(graph.takeRunnableMeshes().size() == 5);
+    CHECK(graph.waitingMeshCount() == 0);
+}
+
+TEST(meshedChunksAreNotRequestedAgain) {
+    ChunkTaskGraph graph(1);
+    for (const Vector3Int& dependency : requestMesh(graph, {0, 0, 0})) {
+        graph.completeGeneration(dependency);
+    }
+    CHECK(graph.takeRunnableMeshes().size() == 1);
+    graph.completeMesh({0, 0, 0});
+
+    CHECK(requestMesh(graph, {0, 0, 0}).empty());
+    CHECK(graph.takeRunnableMeshes().empty());
+    CHECK(graph.isMeshed({0, 0, 0}));
+}
+
+TEST(cancelledMeshesAreRequestedAfresh) {
+    ChunkTaskGraph graph(1);
+    graph.beginRound();
+    (void)requestMesh(graph, {0, 0, 0});
+    graph.beginRound();
+    (void)requestMesh(graph, {5, 0, 0});
+    graph.cancelUnrequestedMeshes();
+    CHECK(graph.waitingMeshCount() == 1);
+
+    // A cancelled mesh no longer becomes runnable, until it is requested again
+    for (const Vector3Int& position :
+         {Vector3Int{0, 0, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}}) {
+        graph.completeGeneration(position);
+    }
+    CHECK(graph.takeRunnableMeshes().empty());
+    CHECK(requestMesh(graph, {0, 0, 0}).empty());
+    CHECK(graph.takeRunnableMeshes() == std::vector<Vector3Int>{{0, 0, 0}});
+}
+
+TEST(runnableMeshesAreListedOnceUntilTaken) {
+    ChunkTaskGraph graph(1);
+    for (const Vector3Int& dependency : requestMesh(graph, {0, 0, 0})) {
+        graph.completeGeneration(dependency);
+    }
+    (void)requestMesh(graph, {0, 0, 0});
+    (void)requestMesh(graph, {0, 0, 0});
+    CHECK(graph.takeRunnableMeshes() == std::vector<Vector3Int>{{0, 0, 0}});
+
+    // Taken but dropped by the caller, then requested again
+    (void)requestMesh(graph, {0, 0, 0});
+    CHECK(graph.takeRunnableMeshes() == std::vector<Vector3Int>{{0, 0, 0}});
+}
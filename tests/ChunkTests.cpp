@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "Test.hpp"
+#include "absl/container/flat_hash_set.h"
+#include "testing/Viewers.hpp"
+#include "world/Chunk.hpp"
+#include "world/Terrain.hpp"
+#include "world/block/BlockMasks.hpp"
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+
+bool haveSameBlocks(const Chunk& first, const Chunk& second) {
+    for (int x = 0; x < Chunk::SIZE_X; x++) {
+        for (int y = 0; y < Chunk::SIZE_Y; y++) {
+            for (int z = 0; z < Chunk::SIZE_Z; z++) {
+                if (first.getData()[x][y][z].type() != second.getData()[x][y][z].type()) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <size_t Size>
+void checkRenderedMask() {
+    // Every block type at every position of the row
+    std::array<Block, Size> row{};
+    for (size_t i = 0; i < Size; i++) {
+        row[i] = Block{static_cast<BlockType>((i * 7 + i / 6) % std::size(BLOCK_DATA))};
+    }
+
+    const BlockRowMask<Size> mask = renderedMask(row);
+    for (size_t i = 0; i < Size; i++) CHECK(((mask >> i) & 1) == row[i].isRendered());
+    if constexpr (Size < 8 * sizeof(mask)) CHECK(mask >> Size == 0);
+}
+
+}  // namespace
+
+TEST(generationIsDeterministic) {
+    Chunk first(3, -2, 0);
+    Chunk second(3, -2, 0);
+    first.generate(SEED, MAP_HEIGHT_BLOCKS);
+    second.generate(SEED, MAP_HEIGHT_BLOCKS);
+
+    CHECK(haveSameBlocks(first, second));
+}
+
+TEST(renderedMaskMatchesBlocks) {
+    checkRenderedMask<16>();
+    checkRenderedMask<32>();
+    checkRenderedMask<48>();
+    checkRenderedMask<64>();
+}
+
+TEST(isolatedChunkMeshIsConsistent) {
+    Chunk chunk(0, 0, 0);
+    chunk.generate(SEED, MAP_HEIGHT_BLOCKS);
+
+    chunk.generateTransforms(std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                             std::nullopt);
+
+    const size_t vertexCount = chunk.getMeshVertices().size() / 3;
+    CHECK(chunk.getMeshVertices().size() % 3 == 0);
+    CHECK(chunk.getMeshNormals().size() == chunk.getMeshVertices().size());
+    CHECK(chunk.getMeshTexcoords().size() == vertexCount * 2);
+    CHECK(chunk.getMeshColors().size() == vertexCount * 4);
+    CHECK(chunk.getMeshIndices().size() % 3 == 0);
+    for (const uint16_t index : chunk.getMeshIndices()) CHECK(index < vertexCount);
+}
+
+TEST(fillMeshesEveryChunkInRange) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    terrain.fill(viewerAt({0.5f, 0.5f, 100.0f}), 2);
+
+    CHECK(!terrain.chunks().empty());
+    CHECK(terrain.pendingGenerationCount() == 0);
+    CHECK(terrain.stats().generatedChunks == terrain.chunks().size());
+    CHECK(!terrain.meshedChunks().empty());
+}
+
+TEST(streamingMeshesEveryChunkOnce) {
+    Terrain terrain(SEED, 128);
+    terrain.fill(viewerAt({0.5f, 0.5f, 100.0f}), 2);
+
+    std::vector<Vector3Int> meshed = terrain.meshedChunks();
+    for (int i = 1; i <= 60; i++) {
+        terrain.update(viewerAt({0.5f, 0.5f + 4.0f * static_cast<float>(i), 100.0f}), 2);
+        meshed.insert(meshed.end(), terrain.meshedChunks().begin(), terrain.meshedChunks().end());
+    }
+
+    absl::flat_hash_set<Vector3Int> distinct(meshed.begin(), meshed.end());
+    CHECK(!meshed.empty());
+    CHECK(distinct.size() == meshed.size());
+    CHECK(terrain.stats().meshedChunks == meshed.size());
+
+    // Every mesh was built with its neighbourhood generated
+    const int columnHeight = terrain.mapHeightBlocks() / Chunk::SIZE_Z;
+    for (const Vector3Int& position : meshed) {
+        const auto neighbours = terrain.findAdjacentChunks(*terrain.findChunk(position));
+        CHECK(std::ranges::all_of(neighbours.begin(), neighbours.begin() + 4,
+                                  [](const auto& neighbour) { return neighbour.has_value(); }));
+        CHECK(neighbours[4].has_value() == (position.z + 1 < columnHeight));
+        CHECK(neighbours[5].has_value() == (position.z > 0));
+    }
+}
@@ -0,0 +1,56 @@
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Test.hpp"
+#include "common/CompletionQueue.hpp"
+
+namespace {
+
+constexpr uint64_t STRESS_ITEMS = 200'000;
+
+}  // namespace
+
+TEST(spscDrainsInOrderAndRejectsWhenFull) {
+    SpscCompletionQueue<std::unique_ptr<int>, 4> queue;
+    for (int i = 0; i < 4; i++) CHECK(queue.tryPush(std::make_unique<int>(i)));
+    auto rejected = std::make_unique<int>(4);
+    CHECK(!queue.tryPush(std::move(rejected)));
+    CHECK(rejected != nullptr);
+
+    std::vector<int> drained;
+    auto take = [&](std::unique_ptr<int>&& item) { drained.push_back(*item); };
+    CHECK(queue.drain(take, 3) == 3);
+    CHECK(queue.tryPush(std::move(rejected)));
+    CHECK(queue.drain(take) == 2);
+    CHECK(queue.drain(take) == 0);
+    CHECK(drained == std::vector<int>{0, 1, 2, 3, 4});
+
+    const CompletionQueueStats stats = queue.stats();
+    CHECK(stats.capacity == 4);
+    CHECK(stats.highWaterMark == 4);
+    CHECK(stats.drained == 5);
+    CHECK(stats.rejectedPushes == 1);
+}
+
+// The stress test is meant to run under ThreadSanitizer as well, see README
+TEST(spscStressDeliversEveryItemInOrder) {
+    SpscCompletionQueue<uint64_t, 256> queue;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < STRESS_ITEMS; i++) {
+            while (!queue.tryPush(uint64_t{i})) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    bool isInOrder = true;
+    while (expected < STRESS_ITEMS) {
+        queue.drain([&](uint64_t&& item) { isInOrder &= item == expected++; }, 64);
+    }
+    producer.join();
+
+    CHECK(isInOrder);
+    CHECK(queue.stats().drained == STRESS_ITEMS);
+    CHECK(queue.stats().highWaterMark <= 256);
+}
@@ -0,0 +1,233 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "MeshSurface.hpp"
+#include "Test.hpp"
+#include "world/Chunk.hpp"
+
+// Golden hashes of the meshes of a few chunks, to catch any change of the mesher's output.
+//
+// A mesher change that is meant to change the geometry (greedy meshing, packed vertices) fails
+// `meshesMatchGoldenHashes`; if `meshesCoverTheVisibleSurface` still passes, the new meshes cover
+// the same faces and the hashes can be regenerated:
+//
+//     MINECRAFT_UPDATE_GOLDEN=1 ./build/minecraft_tests meshesMatchGoldenHashes
+
+namespace {
+
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+const std::string GOLDEN_PATH = std::format("{}/tests/golden/chunk_meshes.txt", CMAKE_ROOT_DIR);
+
+struct MeshCase {
+    int seed;
+    Vector3Int chunk;
+};
+
+// Underground, surface, shore and sky chunks
+constexpr std::array<MeshCase, 12> MESH_CASES = {{
+    {1, {0, 0, 0}},
+    {1, {0, 0, 1}},
+    {1, {-4, -6, 2}},
+    {1, {8, 6, 1}},
+    {1, {9, 4, 4}},
+    {42, {0, 0, 0}},
+    {42, {-3, -3, 1}},
+    {42, {-8, 12, 1}},
+    {1337, {0, 0, 1}},
+    {1337, {-8, 2, 1}},
+    {1337, {-12, 6, 2}},
+    {1337, {-8, 0, 2}},
+}};
+
+/// A generated chunk and its six generated neighbours, the chunk meshed
+template <typename ChunkType = Chunk>
+struct MeshedChunk {
+    std::unique_ptr<ChunkType> chunk;
+    std::array<std::unique_ptr<ChunkType>, 6> neighbours;
+
+    explicit MeshedChunk(const MeshCase& meshCase) {
+        auto generate = [&](const Vector3Int& position) {
+            auto generated = std::make_unique<ChunkType>(position.x, position.y, position.z);
+            generated->generate(meshCase.seed, MAP_HEIGHT_BLOCKS);
+            return generated;
+        };
+        constexpr std::array<Vector3Int, 6> offsets = {{
+            {1, 0, 0},
+            {-1, 0, 0},
+            {0, 1, 0},
+            {0, -1, 0},
+            {0, 0, 1},
+            {0, 0, -1},
+        }};
+        chunk = generate(meshCase.chunk);
+        for (size_t i = 0; i < offsets.size(); i++) {
+            neighbours[i] = generate(meshCase.chunk + offsets[i]);
+        }
+        chunk->generateTransforms(*neighbours[0], *neighbours[1], *neighbours[2], *neighbours[3],
+                                  *neighbours[4], *neighbours[5]);
+    }
+
+    [[nodiscard]] std::array<const ChunkType*, 6> neighbourPointers() const {
+        std::array<const ChunkType*, 6> pointers{};
+        for (size_t i = 0; i < neighbours.size(); i++) pointers[i] = neighbours[i].get();
+        return pointers;
+    }
+};
+
+/// FNV-1a over the mesh streams. Positions and normals are integers and texture coordinates are
+/// quantized, so that the hash does not depend on the float math of a build.
+uint64_t meshHash(const Chunk& chunk) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto add = [&](const int64_t value) {
+        for (int byte = 0; byte < 8; byte++) {
+            hash ^= static_cast<uint64_t>(value >> (8 * byte)) & 0xff;
+            hash *= 0x100000001b3ull;
+        }
+    };
+    for (const float value : chunk.getMeshVertices()) add(std::lround(value));
+    for (const float value : chunk.getMeshNormals()) add(std::lround(value));
+    for (const float value : chunk.getMeshTexcoords()) add(std::lround(value * 65536.0f));
+    for (const unsigned char value : chunk.getMeshColors()) add(value);
+    for (const uint16_t index : chunk.getMeshIndices()) add(index);
+    return hash;
+}
+
+std::string goldenLine(const MeshCase& meshCase, const Chunk& chunk) {
+    return std::format("{} {} {} {} {} {} {:016x}", meshCase.seed, meshCase.chunk.x,
+                       meshCase.chunk.y, meshCase.chunk.z, chunk.getMeshVertices().size() / 3,
+                       chunk.getMeshIndices().size(), meshHash(chunk));
+}
+
+template <typename ChunkType>
+void checkCoversVisibleSurface(const MeshCase& meshCase) {
+    const MeshedChunk<ChunkType> meshed(meshCase);
+    const MeshSurface surface = meshSurface(*meshed.chunk);
+
+    CHECK(!surface.faces.empty());
+    CHECK(surface.overlaps == 0);
+    CHECK(surface == expectedSurface(*meshed.chunk, meshed.neighbourPointers()));
+}
+
+}  // namespace
+
+TEST(meshesMatchGoldenHashes) {
+    std::vector<std::string> lines;
+    for (const MeshCase& meshCase : MESH_CASES) {
+        lines.push_back(goldenLine(meshCase, *MeshedChunk<>(meshCase).chunk));
+    }
+
+    if (std::getenv("MINECRAFT_UPDATE_GOLDEN") != nullptr) {
+        std::ofstream out(GOLDEN_PATH);
+        out << "# seed chunk_x chunk_y chunk_z vertices indices hash, see GoldenMeshTests.cpp\n";
+        for (const std::string& line : lines) out << line << "\n";
+        CHECK(static_cast<bool>(out));
+        return;
+    }
+
+    std::ifstream in(GOLDEN_PATH);
+    CHECK(static_cast<bool>(in));
+    std::vector<std::string> goldenLines;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[0] != '#') goldenLines.push_back(line);
+    }
+
+    CHECK(goldenLines.size() == lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (lines[i] != goldenLines[i]) {
+            throw TestFailure(std::format("mesh changed: expected '{}', got '{}'", goldenLines[i],
+                                          lines[i]));
+        }
+    }
+}
+
+TEST(meshesCoverTheVisibleSurface) {
+    for (const MeshCase& meshCase : MESH_CASES) {
+        const MeshedChunk<> meshed(meshCase);
+        const MeshSurface surface = meshSurface(*meshed.chunk);
+
+        CHECK(surface.invalidTriangles == 0);
+        CHECK(surface.overlaps == 0);
+        CHECK(surface == expectedSurface(*meshed.chunk, meshed.neighbourPointers()));
+    }
+}
+
+TEST(everyChunkConfigurationCoversTheVisibleSurface) {
+    // Chunks crossing the surface, which is 20 to 40 blocks high around the origin
+    checkCoversVisibleSurface<SmallChunk>({1, {0, 0, 1}});
+    checkCoversVisibleSurface<Chunk>({1, {0, 0, 0}});
+    checkCoversVisibleSurface<TallChunk>({1, {0, 0, 0}});
+}
+
+TEST(floatingBlockShowsEveryFaceTowardsItsNormal) {
+    // Generated terrain has no faces looking down, edits do
+    Chunk chunk(0, 0, 0);
+    chunk.setBlock({5, 6, 7}, Block{BlockType::BLOCK_STONE});
+    chunk.generateTransforms(std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                             std::nullopt);
+    const std::array<const Chunk*, 6> neighbours{};
+    CHECK(meshSurface(chunk) == expectedSurface(chunk, neighbours));
+    CHECK(meshSurface(chunk).faces.size() == 6);
+
+    // Counter-clockwise seen from the side the normal points to
+    const std::vector<float>& vertices = chunk.getMeshVertices();
+    const std::vector<float>& normals = chunk.getMeshNormals();
+    const std::vector<uint16_t>& indices = chunk.getMeshIndices();
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        auto corner = [&](const size_t k) {
+            const size_t v = 3 * indices[i + k];
+            return std::array<float, 3>{vertices[v], vertices[v + 1], vertices[v + 2]};
+        };
+        const auto a = corner(0), b = corner(1), c = corner(2);
+        const std::array<float, 3> ab = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const std::array<float, 3> ac = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        const std::array<float, 3> cross = {ab[1] * ac[2] - ab[2] * ac[1],
+                                            ab[2] * ac[0] - ab[0] * ac[2],
+                                            ab[0] * ac[1] - ab[1] * ac[0]};
+        const size_t n = 3 * indices[i];
+        CHECK(cross[0] * normals[n] + cross[1] * normals[n + 1] + cross[2] * normals[n + 2] > 0);
+    }
+}
+
+TEST(surfaceIgnoresTriangulationButNotCoverage) {
+    // The +Z faces of blocks (0, 0, 0) and (1, 0, 0), as two unit quads or as one 2x1 quad
+    std::vector<float> upNormals(3 * 6, 0.0f);
+    for (size_t i = 2; i < upNormals.size(); i += 3) upNormals[i] = 1.0f;
+
+    const std::vector<float> unitQuads = {
+        0, 0, 1,  //
+        1, 0, 1,  //
+        1, 1, 1,  //
+        0, 1, 1,  //
+        2, 0, 1,  //
+        2, 1, 1,  //
+    };
+    const std::vector<uint16_t> unitIndices = {0, 1, 2, 0, 2, 3, 1, 4, 5, 1, 5, 2};
+    const std::vector<float> mergedQuad = {
+        0, 0, 1,  //
+        2, 0, 1,  //
+        2, 1, 1,  //
+        0, 1, 1,  //
+    };
+    const std::vector<uint16_t> mergedIndices = {0, 1, 2, 0, 2, 3};
+
+    const MeshSurface unit = meshSurface(unitQuads, upNormals, unitIndices);
+    const MeshSurface merged = meshSurface(mergedQuad, upNormals, mergedIndices);
+    CHECK(unit.faces.size() == 2);
+    CHECK(unit.overlaps == 0);
+    CHECK(unit == merged);
+
+    const std::vector<uint16_t> missingTriangle = {0, 1, 2};
+    CHECK(meshSurface(mergedQuad, upNormals, missingTriangle) != merged);
+
+    const std::vector<uint16_t> coveredTwice = {0, 1, 2, 0, 2, 3, 0, 1, 2};
+    CHECK(meshSurface(mergedQuad, upNormals, coveredTwice).overlaps == 1);
+}
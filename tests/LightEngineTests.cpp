@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Test.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkMap.hpp"
+#include "world/LightEngine.hpp"
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 512;
+
+/// Chunks of a test world, made of stone and air only
+class TestWorld {
+   public:
+    explicit TestWorld(const int mapHeightBlocks) : light_(chunks_, mapHeightBlocks) {}
+
+    /// Adds a chunk of `type` blocks, lit as if generated
+    void addChunk(const Vector3Int& position, const BlockType type) {
+        auto chunk = std::make_unique<Chunk>(position.x, position.y, position.z);
+        for (int x = 0; x < Chunk::SIZE_X; x++) {
+            for (int y = 0; y < Chunk::SIZE_Y; y++) {
+                for (int z = 0; z < Chunk::SIZE_Z; z++) chunk->setBlock({x, y, z}, Block{type});
+            }
+        }
+        chunk->initializeLight();
+        (void)chunks_.insert(std::move(chunk));
+    }
+
+    void setBlock(const Vector3Int& position, const BlockType type) {
+        Chunk& chunk = *chunks_.find(Chunk::chunkOf(position));
+        const Vector3Int local = Chunk::localOf(position);
+        const Block previous = chunk.getData()[local.x][local.y][local.z];
+        chunk.setBlock(local, Block{type});
+        light_.blockChanged(position, previous);
+    }
+
+    [[nodiscard]] const Block& block(const Vector3Int& position) const {
+        const Vector3Int local = Chunk::localOf(position);
+        return chunks_.find(Chunk::chunkOf(position))->getData()[local.x][local.y][local.z];
+    }
+
+    [[nodiscard]] uint8_t light(const Vector3Int& position, const LightChannel channel) const {
+        return chunks_.find(Chunk::chunkOf(position))->getLight(Chunk::localOf(position), channel);
+    }
+
+    [[nodiscard]] bool contains(const Vector3Int& position) const {
+        return chunks_.contains(Chunk::chunkOf(position));
+    }
+
+    [[nodiscard]] ChunkMap& chunks() { return chunks_; }
+    [[nodiscard]] LightEngine& engine() { return light_; }
+
+   private:
+    ChunkMap chunks_;
+    LightEngine light_;
+};
+
+}  // namespace
+
+TEST(generatedChunksAreSkyLitDownToTheGround) {
+    for (int z = 0; z < MAP_HEIGHT_BLOCKS / Chunk::SIZE_Z; z++) {
+        Chunk chunk(3, -2, z);
+        chunk.generate(SEED, MAP_HEIGHT_BLOCKS);
+        bool isUniform = true;
+        for (int x = 0; x < Chunk::SIZE_X; x++) {
+            for (int y = 0; y < Chunk::SIZE_Y; y++) {
+                bool isUnderGround = false;
+                for (int localZ = Chunk::SIZE_Z - 1; localZ >= 0; localZ--) {
+                    isUnderGround |= chunk.getData()[x][y][localZ].isRendered();
+                    const Vector3Int local = {x, y, localZ};
+                    CHECK(chunk.getLight(local, LightChannel::SKY) ==
+                          (isUnderGround ? 0 : MAX_LIGHT_LEVEL));
+                    CHECK(chunk.getLight(local, LightChannel::BLOCK) == 0);
+                    isUniform &= chunk.getLight(local) == chunk.getLight({0, 0, 0});
+                }
+            }
+        }
+        CHECK(chunk.isLightUniform() == isUniform);
+    }
+}
+
+TEST(skyLightFillsADugShaftUntilItIsCovered) {
+    constexpr int height = 2 * Chunk::SIZE_Z;
+    TestWorld world(height);
+    world.addChunk({0, 0, 0}, BlockType::BLOCK_STONE);
+    world.addChunk({0, 0, 1}, BlockType::BLOCK_AIR);
+
+    // A shaft down from the surface, then a tunnel along X at its bottom
+    for (int z = 31; z >= 26; z--) world.setBlock({16, 16, z}, BlockType::BLOCK_AIR);
+    for (int x = 17; x <= 19; x++) world.setBlock({x, 16, 26}, BlockType::BLOCK_AIR);
+    world.engine().propagate();
+
+    for (int z = 26; z <= 31; z++) CHECK(world.light({16, 16, z}, LightChannel::SKY) == 15);
+    CHECK(world.light({17, 16, 26}, LightChannel::SKY) == 14);
+    CHECK(world.light({19, 16, 26}, LightChannel::SKY) == 12);
+    CHECK(world.light({16, 16, 25}, LightChannel::SKY) == 0);  // Stone
+    CHECK(world.engine().changedChunks().contains({0, 0, 0}));
+    CHECK(world.engine().changedChunks().contains({0, 0, 1}));  // Lit by the top of the shaft
+
+    world.engine().clearChangedChunks();
+    world.setBlock({16, 16, 31}, BlockType::BLOCK_STONE);
+    world.engine().propagate();
+
+    for (int z = 26; z <= 30; z++) CHECK(world.light({16, 16, z}, LightChannel::SKY) == 0);
+    for (int x = 17; x <= 19; x++) CHECK(world.light({x, 16, 26}, LightChannel::SKY) == 0);
+    CHECK(world.light({16, 16, 32}, LightChannel::SKY) == 15);
+}
+
+TEST(lampLightCrossesChunkBordersIntoTheMesh) {
+    TestWorld world(Chunk::SIZE_Z);
+    world.addChunk({0, 0, 0}, BlockType::BLOCK_STONE);
+    world.addChunk({1, 0, 0}, BlockType::BLOCK_STONE);
+
+    // A closed corridor along X across the border, with a lamp at its end
+    for (int x = 20; x < 40; x++) world.setBlock({x, 5, 5}, BlockType::BLOCK_AIR);
+    world.setBlock({19, 5, 5}, BlockType::BLOCK_LAMP);
+    world.engine().propagate();
+
+    CHECK(world.light({19, 5, 5}, LightChannel::BLOCK) == 14);
+    for (int x = 20; x < 40; x++) {
+        CHECK(world.light({x, 5, 5}, LightChannel::BLOCK) == std::max(0, 13 - (x - 20)));
+        CHECK(world.light({x, 5, 5}, LightChannel::SKY) == 0);
+    }
+    CHECK(world.engine().changedChunks().contains({1, 0, 0}));
+
+    // The faces of the corridor are lit by its air
+    Chunk& chunk = *world.chunks().find({0, 0, 0});
+    chunk.generateTransforms(*world.chunks().find({1, 0, 0}), std::nullopt, std::nullopt,
+                             std::nullopt, std::nullopt, std::nullopt);
+    const std::vector<unsigned char>& colors = chunk.getMeshColors();
+    CHECK(colors.size() == chunk.getMeshVertices().size() / 3 * 4);
+    bool hasLampLitFace = false;
+    for (size_t i = 0; i < colors.size(); i += 4) hasLampLitFace |= colors[i + 1] == 13 * 17;
+    CHECK(hasLampLitFace);
+
+    world.setBlock({19, 5, 5}, BlockType::BLOCK_STONE);
+    world.engine().propagate();
+    for (int x = 19; x < 40; x++) CHECK(world.light({x, 5, 5}, LightChannel::BLOCK) == 0);
+}
+
+TEST(incrementalLightMatchesAFullRecomputation) {
+    // Two columns of two chunks: stone below, air above, edited around the ground
+    constexpr int height = 2 * Chunk::SIZE_Z;
+    TestWorld world(height);
+    for (int x = 0; x < 2; x++) {
+        world.addChunk({x, 0, 0}, BlockType::BLOCK_STONE);
+        world.addChunk({x, 0, 1}, BlockType::BLOCK_AIR);
+    }
+
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> blockX(0, 2 * Chunk::SIZE_X - 1);
+    std::uniform_int_distribution<int> blockY(0, Chunk::SIZE_Y - 1);
+    std::uniform_int_distribution<int> blockZ(Chunk::SIZE_Z - 8, Chunk::SIZE_Z + 8);
+    std::uniform_int_distribution<int> type(0, 9);
+    for (int batch = 0; batch < 40; batch++) {
+        for (int edit = 0; edit < 50; edit++) {
+            const int roll = type(random);
+            world.setBlock({blockX(random), blockY(random), blockZ(random)},
+                           roll == 0   ? BlockType::BLOCK_LAMP
+                           : roll <= 4 ? BlockType::BLOCK_STONE
+                                       : BlockType::BLOCK_AIR);
+        }
+        world.engine().propagate();
+    }
+
+    // Flood fill from scratch: the sky above the top and every lamp
+    for (const LightChannel channel : {LightChannel::SKY, LightChannel::BLOCK}) {
+        std::vector<uint8_t> expected(2 * Chunk::SIZE_X * Chunk::SIZE_Y * height, 0);
+        auto index = [](const Vector3Int& p) {
+            return (static_cast<size_t>(p.x) * Chunk::SIZE_Y + p.y) * height + p.z;
+        };
+        std::vector<Vector3Int> queue;
+        for (int x = 0; x < 2 * Chunk::SIZE_X; x++) {
+            for (int y = 0; y < Chunk::SIZE_Y; y++) {
+                for (int z = 0; z < height; z++) {
+                    const Block& block = world.block({x, y, z});
+                    uint8_t level = 0;
+                    if (channel == LightChannel::SKY) {
+                        level = z == height - 1 && !block.isRendered() ? MAX_LIGHT_LEVEL : 0;
+                    } else {
+                        level = block.lightEmission();
+                    }
+                    if (level == 0) continue;
+                    expected[index({x, y, z})] = level;
+                    queue.push_back({x, y, z});
+                }
+            }
+        }
+        constexpr std::array<Vector3Int, 6> offsets = {
+            {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}}};
+        for (size_t i = 0; i < queue.size(); i++) {
+            const uint8_t level = expected[index(queue[i])];
+            for (const Vector3Int& offset : offsets) {
+                const Vector3Int next = queue[i] + offset;
+                if (next.z < 0 || next.z >= height || !world.contains(next) ||
+                    world.block(next).isRendered()) {
+                    continue;
+                }
+                const bool isStraightDown =
+                    channel == LightChannel::SKY && offset.z == -1 && level == MAX_LIGHT_LEVEL;
+                const int spread = isStraightDown ? level : level - 1;
+                if (expected[index(next)] < spread) {
+                    expected[index(next)] = static_cast<uint8_t>(spread);
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        int mismatches = 0;
+        for (int x = 0; x < 2 * Chunk::SIZE_X; x++) {
+            for (int y = 0; y < Chunk::SIZE_Y; y++) {
+                for (int z = 0; z < height; z++) {
+                    mismatches += world.light({x, y, z}, channel) != expected[index({x, y, z})];
+                }
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+}
@@ -0,0 +1,40 @@
+#include "Test.hpp"
+#include "common/MemoryAccounting.hpp"
+#include "testing/Viewers.hpp"
+#include "world/Chunk.hpp"
+#include "world/HeightMap.hpp"
+#include "world/Terrain.hpp"
+
+TEST(chunksAreAccountedUntilDestroyed) {
+    const size_t before = MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA);
+    {
+        Chunk chunk(0, 0, 0);
+        CHECK(MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA) ==
+              before + sizeof(Chunk::ChunkData));
+    }
+    CHECK(MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA) == before);
+}
+
+TEST(heightCacheIsAccountedAndReleased) {
+    clearHeightCache();
+    (void)getHeight(0, 0, 1, 512);
+    CHECK(MemoryAccounting::bytes(MemoryCategory::HEIGHT_CACHE) == heightCacheBytes());
+    CHECK(MemoryAccounting::bytes(MemoryCategory::HEIGHT_CACHE) > 0);
+
+    clearHeightCache();
+    CHECK(MemoryAccounting::bytes(MemoryCategory::HEIGHT_CACHE) == heightCacheBytes());
+}
+
+TEST(chunkDataBudgetStopsGeneration) {
+    const size_t budget = 10 * sizeof(Chunk::ChunkData);
+    MemoryAccounting::setBudget(MemoryCategory::CHUNK_DATA,
+                                MemoryAccounting::bytes(MemoryCategory::CHUNK_DATA) + budget);
+    {
+        Terrain terrain(1, 512);
+        terrain.fill(viewerAt({0.5f, 0.5f, 100.0f}), 4);
+
+        CHECK(terrain.chunks().size() <= 11);
+        CHECK(terrain.stats().memoryBudgetStalls > 0);
+    }
+    MemoryAccounting::setBudget(MemoryCategory::CHUNK_DATA, MemoryAccounting::NO_BUDGET);
+}
@@ -0,0 +1,165 @@
+#include "MeshSurface.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr std::array<Vector3Int, 6> DIRECTIONS = {{
+    {1, 0, 0},
+    {-1, 0, 0},
+    {0, 1, 0},
+    {0, -1, 0},
+    {0, 0, 1},
+    {0, 0, -1},
+}};
+
+// Where a unit cell is sampled, off its center so that the sample is not on the diagonal of a quad
+constexpr float SAMPLE_U = 0.513f;
+constexpr float SAMPLE_V = 0.527f;
+
+int& component(Vector3Int& vector, const int axis) {
+    return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+}
+
+/// Twice the signed area of (a, b, p): positive when p is on the left of a -> b
+float edge(const Vector2& a, const Vector2& b, const Vector2& p) {
+    return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+
+/// Index in DIRECTIONS of an exact unit axis normal, or -1
+int directionOf(const Vector3& normal) {
+    for (int direction = 0; direction < 6; direction++) {
+        const Vector3Int& d = DIRECTIONS[direction];
+        if (normal.x == static_cast<float>(d.x) && normal.y == static_cast<float>(d.y) &&
+            normal.z == static_cast<float>(d.z)) {
+            return direction;
+        }
+    }
+    return -1;
+}
+
+template <typename Index>
+MeshSurface surfaceOf(const std::span<const float> vertices, const std::span<const float> normals,
+                      const std::span<const Index> indices) {
+    MeshSurface surface;
+    std::vector<VisibleFace> covered;
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const std::array<size_t, 3> triangle = {indices[t], indices[t + 1], indices[t + 2]};
+        const size_t first = triangle[0];
+        const int direction =
+            directionOf({normals[3 * first], normals[3 * first + 1], normals[3 * first + 2]});
+        if (direction < 0) {
+            surface.invalidTriangles++;
+            continue;
+        }
+
+        // The triangle must lie in an integer plane across the normal's axis
+        const int axis = direction / 2;
+        const int uAxis = (axis + 1) % 3;
+        const int vAxis = (axis + 2) % 3;
+        const float plane = vertices[3 * first + axis];
+        std::array<Vector2, 3> points{};
+        bool isInPlane = plane == std::round(plane);
+        for (size_t i = 0; i < 3; i++) {
+            isInPlane = isInPlane && vertices[3 * triangle[i] + axis] == plane;
+            points[i] = {vertices[3 * triangle[i] + uAxis], vertices[3 * triangle[i] + vAxis]};
+        }
+        const float area = edge(points[0], points[1], points[2]);
+        if (!isInPlane || area == 0.0f) {
+            surface.invalidTriangles++;
+            continue;
+        }
+
+        const auto [minU, maxU] = std::minmax({points[0].x, points[1].x, points[2].x});
+        const auto [minV, maxV] = std::minmax({points[0].y, points[1].y, points[2].y});
+        for (int u = static_cast<int>(std::floor(minU)); u < static_cast<int>(std::ceil(maxU));
+             u++) {
+            for (int v = static_cast<int>(std::floor(minV)); v < static_cast<int>(std::ceil(maxV));
+                 v++) {
+                const Vector2 sample = {static_cast<float>(u) + SAMPLE_U,
+                                        static_cast<float>(v) + SAMPLE_V};
+                const float e0 = edge(points[0], points[1], sample);
+                const float e1 = edge(points[1], points[2], sample);
+                const float e2 = edge(points[2], points[0], sample);
+                const bool isInside = area > 0 ? (e0 > 0 && e1 > 0 && e2 > 0)
+                                               : (e0 < 0 && e1 < 0 && e2 < 0);
+                if (!isInside) continue;
+
+                // A face towards +axis lies on the far side of its block
+                Vector3Int block{};
+                component(block, axis) = static_cast<int>(plane) - (direction % 2 == 0 ? 1 : 0);
+                component(block, uAxis) = u;
+                component(block, vAxis) = v;
+                covered.push_back({block, static_cast<uint8_t>(direction)});
+            }
+        }
+    }
+
+    std::ranges::sort(covered);
+    for (size_t i = 0; i < covered.size(); i++) {
+        if (i > 0 && covered[i] == covered[i - 1]) {
+            // Counted once per face, however many times it is covered
+            if (i == 1 || covered[i - 1] != covered[i - 2]) surface.overlaps++;
+            continue;
+        }
+        surface.faces.push_back(covered[i]);
+    }
+    return surface;
+}
+
+}  // namespace
+
+MeshSurface meshSurface(const std::span<const float> vertices, const std::span<const float> normals,
+                        const std::span<const uint16_t> indices) {
+    return surfaceOf(vertices, normals, indices);
+}
+
+MeshSurface meshSurface(const std::span<const float> vertices, const std::span<const float> normals,
+                        const std::span<const uint32_t> indices) {
+    return surfaceOf(vertices, normals, indices);
+}
+
+template <typename ChunkType>
+MeshSurface expectedSurface(
+    const ChunkType& chunk,
+    const std::type_identity_t<std::span<const ChunkType* const, 6>> neighbours) {
+    constexpr std::array<int, 3> sizes = {ChunkType::SIZE_X, ChunkType::SIZE_Y, ChunkType::SIZE_Z};
+
+    auto isRendered = [&](Vector3Int position) {
+        for (int direction = 0; direction < 6; direction++) {
+            const int axis = direction / 2;
+            const int outside = direction % 2 == 0 ? sizes[axis] : -1;
+            if (component(position, axis) != outside) continue;
+
+            const ChunkType* neighbour = neighbours[direction];
+            if (neighbour == nullptr) return true;  // The mesher treats missing chunks as solid
+            component(position, axis) = direction % 2 == 0 ? 0 : sizes[axis] - 1;
+            return neighbour->getData()[position.x][position.y][position.z].isRendered();
+        }
+        return chunk.getData()[position.x][position.y][position.z].isRendered();
+    };
+
+    MeshSurface surface;
+    for (int x = 0; x < ChunkType::SIZE_X; x++) {
+        for (int y = 0; y < ChunkType::SIZE_Y; y++) {
+            for (int z = 0; z < ChunkType::SIZE_Z; z++) {
+                if (!chunk.getData()[x][y][z].isRendered()) continue;
+                for (int direction = 0; direction < 6; direction++) {
+                    const Vector3Int& d = DIRECTIONS[direction];
+                    if (!isRendered({x + d.x, y + d.y, z + d.z})) {
+                        surface.faces.push_back({{x, y, z}, static_cast<uint8_t>(direction)});
+                    }
+                }
+            }
+        }
+    }
+    std::ranges::sort(surface.faces);
+    return surface;
+}
+
+template MeshSurface expectedSurface(const SmallChunk&, std::span<const SmallChunk* const, 6>);
+template MeshSurface expectedSurface(const Chunk&, std::span<const Chunk* const, 6>);
+template MeshSurface expectedSurface(const TallChunk&, std::span<const TallChunk* const, 6>);
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "common/UtilityStructures.hpp"
+#include "world/Chunk.hpp"
+
+/// A unit face of a block, `direction` indexing +X, -X, +Y, -Y, +Z, -Z
+struct VisibleFace {
+    Vector3Int block;
+    uint8_t direction;
+
+    auto operator<=>(const VisibleFace& other) const {
+        return std::tie(block.x, block.y, block.z, direction) <=>
+               std::tie(other.block.x, other.block.y, other.block.z, other.direction);
+    }
+    bool operator==(const VisibleFace& other) const = default;
+};
+
+/// The unit block faces a mesh covers, whatever its triangulation: a greedy mesher's 4x2 quad
+/// covers the same faces as 8 unit quads. Lets meshers that change the topology be checked
+/// against each other or against `expectedSurface`. Texture coordinates are not compared.
+struct MeshSurface {
+    std::vector<VisibleFace> faces;  // Sorted, without duplicates
+    size_t overlaps = 0;             // Faces covered by more than one triangle
+    size_t invalidTriangles = 0;     // Triangles that are not axis aligned with a unit normal
+
+    bool operator==(const MeshSurface& other) const = default;
+};
+
+/// Surface covered by a mesh in chunk-local coordinates, in the layout of `BasicChunk`'s mesh
+MeshSurface meshSurface(std::span<const float> vertices, std::span<const float> normals,
+                        std::span<const uint16_t> indices);
+MeshSurface meshSurface(std::span<const float> vertices, std::span<const float> normals,
+                        std::span<const uint32_t> indices);
+
+/// Surface covered by the mesh of the chunk, across its submeshes
+template <int SizeX, int SizeY, int SizeZ>
+MeshSurface meshSurface(const BasicChunk<SizeX, SizeY, SizeZ>& chunk) {
+    if (chunk.submeshCount() <= 1) {
+        return meshSurface(chunk.getMeshVertices(), chunk.getMeshNormals(), chunk.getMeshIndices());
+    }
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < chunk.submeshCount(); i++) {
+        const auto submesh = chunk.getSubmesh(i);
+        for (size_t index = 0; index < submesh.indexCount; index++) {
+            indices.push_back(
+                static_cast<uint32_t>(submesh.firstVertex +
+                                      chunk.getMeshIndices()[submesh.firstIndex + index]));
+        }
+    }
+    return meshSurface(chunk.getMeshVertices(), chunk.getMeshNormals(), indices);
+}
+
+/// Faces a correct mesher must produce: rendered blocks next to blocks that are not rendered,
+/// looking across chunk borders into the given neighbours (in the order of `generateTransforms`,
+/// nullptr for a missing neighbour, whose blocks count as solid like the mesher does).
+/// Instantiated for the configurations of Chunk.hpp.
+template <typename ChunkType>
+MeshSurface expectedSurface(const ChunkType& chunk,
+                            std::type_identity_t<std::span<const ChunkType* const, 6>> neighbours);
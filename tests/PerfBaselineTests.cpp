@@ -0,0 +1,57 @@
+#include <sstream>
+#include <utility>
+
+#include "Test.hpp"
+#include "common/PerfBaseline.hpp"
+
+namespace {
+
+PerfBaseline parseBaseline(const std::string& text) {
+    std::istringstream in(text);
+    const std::optional<PerfBaseline> baseline = PerfBaseline::parse(in);
+    CHECK(baseline.has_value());
+    return *baseline;
+}
+
+}  // namespace
+
+TEST(baselineParsesEntriesAndSkipsComments) {
+    const PerfBaseline baseline = parseBaseline("# comment\n\nthroughput 100 0.25\nsize 8 0\n");
+    CHECK(baseline.entries().size() == 2);
+    CHECK(baseline.entries()[0].name == "throughput");
+    CHECK(baseline.entries()[0].value == 100.0);
+    CHECK(baseline.entries()[0].tolerance == 0.25);
+
+    std::istringstream invalid("throughput 100\n");
+    CHECK(!PerfBaseline::parse(invalid).has_value());
+}
+
+TEST(baselineFlagsRegressionsBeyondTolerance) {
+    const PerfBaseline baseline = parseBaseline("throughput 100 0.25\nsize 100 0.1\n");
+
+    auto isRegression = [&](const double throughput, const double size) {
+        const auto comparisons = baseline.compare({
+            {.name = "throughput", .value = throughput, .isHigherBetter = true},
+            {.name = "size", .value = size},
+        });
+        return std::pair{comparisons[0].isRegression, comparisons[1].isRegression};
+    };
+    CHECK(isRegression(80, 105) == std::pair{false, false});
+    CHECK(isRegression(70, 95) == std::pair{true, false});
+    CHECK(isRegression(200, 120) == std::pair{false, true});
+}
+
+TEST(baselineFlagsMissingMetricsAndAppliesOverride) {
+    const PerfBaseline baseline = parseBaseline("throughput 100 0.25\nremoved 1 0\n");
+    const auto comparisons = baseline.compare(
+        {{.name = "throughput", .value = 90, .isHigherBetter = true}, {.name = "new", .value = 1}},
+        0.05);
+
+    CHECK(comparisons.size() == 3);
+    CHECK(comparisons[0].isRegression);  // -10% with a 5% tolerance
+    CHECK(!comparisons[1].baseline.has_value());
+    CHECK(!comparisons[1].isRegression);
+    CHECK(comparisons[2].name == "removed");
+    CHECK(!comparisons[2].value.has_value());
+    CHECK(comparisons[2].isRegression);
+}
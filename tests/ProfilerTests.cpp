@@ -0,0 +1,46 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Test.hpp"
+#include "common/Profiler.hpp"
+
+TEST(profilerStressExportsWhileThreadsRecord) {
+    // More events than a ring holds, so that the exports race with slots being overwritten
+    constexpr uint64_t eventsPerThread = 3 * Profiler::EVENTS_PER_THREAD;
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "minecraft_profiler_stress.json").string();
+
+    std::atomic<int> finished = 0;
+    std::vector<std::jthread> threads;
+    for (int thread = 0; thread < 2; thread++) {
+        threads.emplace_back([&, thread] {
+            Profiler::setThreadName(thread == 0 ? "profiler stress 0" : "profiler stress 1");
+            for (uint64_t i = 0; i < eventsPerThread; i++) {
+                const uint64_t now = get_cycles();
+                Profiler::record("stress zone", now, now + 1);
+            }
+            finished.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    int exports = 0;
+    while (finished.load(std::memory_order_acquire) < 2 || exports == 0) {
+        CHECK(Profiler::exportChromeTrace(path));
+        exports++;
+    }
+    threads.clear();
+
+    CHECK(Profiler::exportChromeTrace(path));
+    std::stringstream trace;
+    trace << std::ifstream(path).rdbuf();
+    const std::string json = trace.str();
+    CHECK(json.contains("\"profiler stress 0\"") && json.contains("\"profiler stress 1\""));
+    CHECK(json.contains("\"stress zone\""));
+    CHECK(json.ends_with("]}\n"));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,144 @@
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+
+#include "Test.hpp"
+#include "testing/Viewers.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkMap.hpp"
+#include "world/Raycast.hpp"
+#include "world/Terrain.hpp"
+
+namespace {
+
+constexpr int SEED = 1;
+constexpr int MAP_HEIGHT_BLOCKS = 128;
+
+/// Adds an air chunk at `position` holding a stone block at each of `stones`, local to it
+void addChunk(ChunkMap& chunks, const Vector3Int& position,
+              std::initializer_list<Vector3Int> stones) {
+    auto chunk = std::make_unique<Chunk>(position.x, position.y, position.z);
+    for (const Vector3Int& stone : stones) chunk->setBlock(stone, Block{BlockType::BLOCK_STONE});
+    (void)chunks.insert(std::move(chunk));
+}
+
+bool operator==(const RaycastHit& a, const RaycastHit& b) {
+    return a.block == b.block && a.normal == b.normal && a.distance == b.distance;
+}
+
+/// The plain DDA, looking every block up
+std::optional<RaycastHit> walkBlocks(const Terrain& terrain, const Vector3& origin,
+                                     const Vector3& direction, const float maxDistance) {
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y +
+                                   direction.z * direction.z);
+    const std::array<float, 3> start = {origin.x, origin.y, origin.z};
+    const std::array<float, 3> unit = {direction.x / length, direction.y / length,
+                                       direction.z / length};
+    std::array<int, 3> block{};
+    for (size_t axis = 0; axis < 3; axis++) {
+        block[axis] = static_cast<int>(std::floor(start[axis]));
+    }
+
+    float distance = 0;
+    Vector3Int normal = {0, 0, 0};
+    while (distance <= maxDistance) {
+        const Vector3Int position = {block[0], block[1], block[2]};
+        const std::optional<Block> found = terrain.findBlock(position);
+        if (found && found->isRendered()) return RaycastHit{position, normal, distance};
+
+        size_t nextAxis = 0;
+        float next = std::numeric_limits<float>::infinity();
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (unit[axis] == 0) continue;
+            const int face = unit[axis] > 0 ? block[axis] + 1 : block[axis];
+            const float crossing = (static_cast<float>(face) - start[axis]) * (1.0f / unit[axis]);
+            if (crossing < next) {
+                next = crossing;
+                nextAxis = axis;
+            }
+        }
+        const int step = unit[nextAxis] > 0 ? 1 : -1;
+        block[nextAxis] += step;
+        distance = next;
+        normal = {nextAxis == 0 ? -step : 0, nextAxis == 1 ? -step : 0, nextAxis == 2 ? -step : 0};
+    }
+    return std::nullopt;
+}
+
+}  // namespace
+
+TEST(raycastsHitTheFaceTheyEnter) {
+    ChunkMap chunks;
+    addChunk(chunks, {0, 0, 0}, {{10, 10, 10}, {5, 5, 31}});
+    addChunk(chunks, {3, 0, 0}, {{4, 5, 5}});
+
+    auto hit = raycast(chunks, {10.5f, 0.5f, 10.5f}, {0.0f, 1.0f, 0.0f}, 20.0f);
+    CHECK(hit && hit->block == Vector3Int{10, 10, 10});
+    CHECK(hit && hit->normal == Vector3Int{0, -1, 0} && hit->distance == 9.5f);
+
+    hit = raycast(chunks, {10.5f, 10.5f, 20.5f}, {0.0f, 0.0f, -3.0f}, 20.0f);
+    CHECK(hit && hit->block == Vector3Int{10, 10, 10});
+    CHECK(hit && hit->normal == Vector3Int{0, 0, 1} && hit->distance == 9.5f);
+
+    // Diagonally through edges, stepping along X first
+    hit = raycast(chunks, {12.0f, 12.0f, 10.5f}, {-1.0f, -1.0f, 0.0f}, 20.0f);
+    CHECK(hit && hit->block == Vector3Int{10, 10, 10} && hit->normal == Vector3Int{0, 1, 0});
+    CHECK(hit && std::abs(hit->distance - std::sqrt(2.0f)) < 1e-5f);
+
+    // From inside, and out of reach
+    hit = raycast(chunks, {10.2f, 10.7f, 10.5f}, {1.0f, 0.0f, 0.0f}, 20.0f);
+    CHECK(hit && hit->normal == Vector3Int{0, 0, 0} && hit->distance == 0.0f);
+    CHECK(!raycast(chunks, {10.5f, 0.5f, 10.5f}, {0.0f, 1.0f, 0.0f}, 9.0f));
+    CHECK(!raycast(chunks, {10.5f, 0.5f, 10.5f}, {0.0f, -1.0f, 0.0f}, 100.0f));
+    CHECK(!raycast(chunks, {10.5f, 0.5f, 10.5f}, {0.0f, 0.0f, 0.0f}, 100.0f));
+
+    // Across the columns of a chunk, past two missing chunks, into a third
+    hit = raycast(chunks, {0.5f, 5.5f, 5.5f}, {1.0f, 0.0f, 0.0f}, 200.0f);
+    CHECK(hit && hit->block == Vector3Int{100, 5, 5});
+    CHECK(hit && hit->normal == Vector3Int{-1, 0, 0} && hit->distance == 99.5f);
+
+    // Up an occupied column
+    hit = raycast(chunks, {5.5f, 5.5f, -40.5f}, {0.0f, 0.0f, 1.0f}, 200.0f);
+    CHECK(hit && hit->block == Vector3Int{5, 5, 31});
+    CHECK(hit && hit->normal == Vector3Int{0, 0, -1} && hit->distance == 71.5f);
+}
+
+TEST(raycastsMatchABlockByBlockWalk) {
+    Terrain terrain(SEED, MAP_HEIGHT_BLOCKS);
+    terrain.fill(viewerAt({0.5f, 0.5f, 100.0f}), 2);
+
+    // Caves in the ground and floating blocks in the sky
+    const int ground = terrain.generateSpawnColumn(0, 0);
+    (void)terrain.fillSphere({10.0f, -12.0f, static_cast<float>(ground)}, 9.0f,
+                             Block{BlockType::BLOCK_AIR});
+    (void)terrain.fillBox({-20, 5, ground + 20}, {-10, 8, ground + 22},
+                          Block{BlockType::BLOCK_STONE});
+    (void)terrain.fillSphere({20.0f, 20.0f, static_cast<float>(ground + 40)}, 4.0f,
+                             Block{BlockType::BLOCK_LAMP});
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> horizontal(-48.0f, 48.0f);
+    std::uniform_real_distribution<float> vertical(-8.0f, MAP_HEIGHT_BLOCKS + 8.0f);
+    std::normal_distribution<float> direction(0.0f, 1.0f);
+    int hits = 0;
+    int misses = 0;
+    int mismatches = 0;
+    for (int ray = 0; ray < 3000; ray++) {
+        const Vector3 origin = {horizontal(random), horizontal(random), vertical(random)};
+        Vector3 towards = {direction(random), direction(random), direction(random)};
+        if (ray % 10 == 0) towards.x = 0;  // Parallel to faces
+        if (ray % 7 == 0) towards.z = 0;
+
+        const std::optional<RaycastHit> hit = raycast(terrain.chunks(), origin, towards, 96.0f);
+        const std::optional<RaycastHit> expected = walkBlocks(terrain, origin, towards, 96.0f);
+        mismatches += hit.has_value() != expected.has_value() || (hit && !(*hit == *expected));
+        hit ? hits++ : misses++;
+    }
+    CHECK(mismatches == 0);
+    CHECK(hits > 500);
+    CHECK(misses > 500);
+}
@@ -0,0 +1,70 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "Test.hpp"
+#include "common/SnapshotBuffer.hpp"
+
+namespace {
+
+struct Snapshot {
+    uint64_t version = 0;
+    std::array<uint64_t, 15> copies{};  // All equal to version once published
+};
+
+}  // namespace
+
+TEST(snapshotBufferAcquiresTheNewestPublished) {
+    SnapshotBuffer<Snapshot> buffer;
+    CHECK(buffer.acquire().version == 0);
+
+    buffer.back().version = 1;
+    buffer.publish();
+    CHECK(buffer.acquire().version == 1);
+    CHECK(buffer.acquire().version == 1);
+
+    for (uint64_t version = 2; version <= 4; version++) {
+        buffer.back().version = version;
+        buffer.publish();
+    }
+    CHECK(buffer.acquire().version == 4);
+
+    // The producer never gets the buffer the consumer holds
+    buffer.back().version = 5;
+    CHECK(buffer.acquire().version == 4);
+}
+
+// Meant to run under ThreadSanitizer as well, see README
+TEST(snapshotBufferStressNeverTearsOrGoesBack) {
+    constexpr uint64_t versions = 200'000;
+
+    SnapshotBuffer<Snapshot> buffer;
+    std::atomic<bool> isDone = false;
+    std::thread producer([&] {
+        for (uint64_t version = 1; version <= versions; version++) {
+            Snapshot& snapshot = buffer.back();
+            snapshot.version = version;
+            snapshot.copies.fill(version);
+            buffer.publish();
+        }
+        isDone = true;
+    });
+
+    uint64_t lastVersion = 0;
+    int torn = 0;
+    int wentBack = 0;
+    while (true) {
+        const bool wasDone = isDone.load();
+        const Snapshot& snapshot = buffer.acquire();
+        for (const uint64_t copy : snapshot.copies) torn += copy != snapshot.version;
+        wentBack += snapshot.version < lastVersion;
+        lastVersion = snapshot.version;
+        if (wasDone) break;
+    }
+    producer.join();
+
+    CHECK(torn == 0);
+    CHECK(wentBack == 0);
+    CHECK(lastVersion == versions);
+}
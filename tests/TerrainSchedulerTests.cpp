@@ -0,0 +1,46 @@
+#include <cmath>
+
+#include "Test.hpp"
+#include "world/TerrainScheduler.hpp"
+
+namespace {
+
+int distanceSqr(const Vector2Int& offset) { return offset.x * offset.x + offset.y * offset.y; }
+
+}  // namespace
+
+TEST(offsetsAreSortedByDistance) {
+    TerrainScheduler scheduler(1);
+    (void)scheduler.update({0, 0}, 8, {}, [](const Vector3Int&) { return false; });
+
+    const auto& offsets = scheduler.offsets();
+    CHECK(!offsets.empty());
+    CHECK(offsets.front() == Vector2Int{0, 0});
+    for (size_t i = 1; i < offsets.size(); i++) {
+        CHECK(distanceSqr(offsets[i - 1]) <= distanceSqr(offsets[i]));
+    }
+}
+
+TEST(offsetsStayWithinRenderDistance) {
+    constexpr int renderDistance = 6;
+    TerrainScheduler scheduler(1);
+    (void)scheduler.update({0, 0}, renderDistance, {}, [](const Vector3Int&) { return false; });
+
+    for (const Vector2Int& offset : scheduler.offsets()) {
+        CHECK(std::abs(offset.x) <= renderDistance);
+        CHECK(std::abs(offset.y) <= renderDistance);
+    }
+}
+
+TEST(updateQueuesWholeColumnsOnlyOnChange) {
+    constexpr int columnHeight = 4;
+    TerrainScheduler scheduler(columnHeight);
+    auto isLoaded = [](const Vector3Int& position) { return position.z == 0; };
+
+    CHECK(scheduler.update({0, 0}, 3, {}, isLoaded));
+    CHECK(scheduler.pendingCount() == scheduler.offsets().size() * (columnHeight - 1));
+
+    CHECK(!scheduler.update({0, 0}, 3, {}, isLoaded));
+    CHECK(scheduler.update({1, 0}, 3, {}, isLoaded));
+    CHECK(scheduler.update({1, 0}, 4, {}, isLoaded));
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <format>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Minimal test registry: `TEST(name) { ... }` defines and registers a test, `CHECK(condition)`
+/// fails it with the location of the failed condition. Tests are run by tests/main.cpp.
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+struct TestRegistration {
+    TestRegistration(const char* name, void (*run)()) { testRegistry().push_back({name, run}); }
+};
+
+struct TestFailure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+inline void check(const bool condition, const char* expression,
+                  const std::source_location location = std::source_location::current()) {
+    if (!condition) {
+        throw TestFailure(std::format("{}:{}: CHECK({}) failed", location.file_name(),
+                                      location.line(), expression));
+    }
+}
+
+#define TEST(name)                                                   \
+    static void name();                                              \
+    static const TestRegistration name##Registration_{#name, &name}; \
+    static void name()
+
+#define CHECK(...) check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__)
@@ -0,0 +1,28 @@
+#include <exception>
+#include <iostream>
+#include <string_view>
+
+#include "Test.hpp"
+
+/// Runs every registered test, or only those whose name contains the first argument
+int main(int argc, char** argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    int failed = 0;
+    int run = 0;
+    for (const auto& [name, test] : testRegistry()) {
+        if (!std::string_view(name).contains(filter)) continue;
+
+        run++;
+        try {
+            test();
+            std::cout << "[ OK ] " << name << std::endl;
+        } catch (const std::exception& e) {
+            failed++;
+            std::cout << "[FAIL] " << name << ": " << e.what() << std::endl;
+        }
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+    return failed == 0 && run > 0 ? 0 : 1;
+}